@@ -0,0 +1,244 @@
+#ifndef MATRIX_SRC_S21_FIXED_MATRIX_H
+#define MATRIX_SRC_S21_FIXED_MATRIX_H
+
+#include <array>
+#include <stdexcept>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_small.h"
+
+// Матрица с размерами, известными при компиляции.
+// Элементы лежат построчно во встроенном std::array без обращения к куче,
+// несовпадение размеров в SumMatrix / MulMatrix — ошибка компиляции.
+// Определитель, обратная матрица и алгебраические дополнения для N <= 4
+// вычисляются явными формулами, для больших N — через S21Matrix.
+template <int R, int C>
+class S21FixedMatrix {
+  static_assert(R > 0 && C > 0, "Matrix dimensions must be positive");
+
+ public:
+  // Точность сравнения в EqMatrix — та же, что у S21Matrix
+  static constexpr double kEpsilon = S21MatrixTraits<double>::kEpsilon;
+
+  constexpr S21FixedMatrix() : matrix_{} {}
+  explicit constexpr S21FixedMatrix(const std::array<double, R * C>& values)
+      : matrix_(values) {}
+  explicit S21FixedMatrix(const S21Matrix& other) : matrix_{} {
+    if (other.GetRows() != R || other.GetCols() != C) {
+      throw std::invalid_argument("Sizes of matrices are different");
+    }
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        matrix_[i * C + j] = other(i, j);
+      }
+    }
+  }
+
+  explicit operator S21Matrix() const {
+    S21Matrix result(R, C);
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        result(i, j) = matrix_[i * C + j];
+      }
+    }
+    return result;
+  }
+
+  static constexpr int GetRows() { return R; }
+  static constexpr int GetCols() { return C; }
+
+  constexpr bool EqMatrix(const S21FixedMatrix& other) const {
+    for (int k = 0; k < R * C; k++) {
+      const double diff = matrix_[k] - other.matrix_[k];
+      if (diff > kEpsilon || diff < -kEpsilon) return false;
+    }
+    return true;
+  }
+
+  constexpr void SumMatrix(const S21FixedMatrix& other) {
+    for (int k = 0; k < R * C; k++) matrix_[k] += other.matrix_[k];
+  }
+
+  constexpr void SubMatrix(const S21FixedMatrix& other) {
+    for (int k = 0; k < R * C; k++) matrix_[k] -= other.matrix_[k];
+  }
+
+  constexpr void MulNumber(const double num) {
+    for (int k = 0; k < R * C; k++) matrix_[k] *= num;
+  }
+
+  // На месте можно умножить только на квадратную матрицу порядка C
+  constexpr void MulMatrix(const S21FixedMatrix<C, C>& other) {
+    *this = *this * other;
+  }
+
+  constexpr S21FixedMatrix<C, R> Transpose() const {
+    S21FixedMatrix<C, R> result;
+    for (int i = 0; i < R; i++) {
+      for (int j = 0; j < C; j++) {
+        result(j, i) = matrix_[i * C + j];
+      }
+    }
+    return result;
+  }
+
+  constexpr S21FixedMatrix CalcComplements() const {
+    static_assert(R == C, "Matrix isn't square");
+    if constexpr (R <= 4) {
+      return Adjugate().Transpose();
+    } else {
+      return S21FixedMatrix(static_cast<S21Matrix>(*this).CalcComplements());
+    }
+  }
+
+  constexpr double Determinant() const {
+    static_assert(R == C, "Matrix isn't square");
+    if constexpr (R <= 4) {
+      return s21::small_matrix::ClosedDeterminant<double, R>(Element());
+    } else {
+      return static_cast<S21Matrix>(*this).Determinant();
+    }
+  }
+
+  // Вырожденность проверяется тем же правилом, что и в S21Matrix,
+  // а не сравнением определителя с нулём
+  constexpr S21FixedMatrix InverseMatrix() const {
+    static_assert(R == C, "Matrix isn't square");
+    if constexpr (R <= 4) {
+      if (s21::small_matrix::IsSingular<double, R>(Element())) {
+        throw std::out_of_range("Determenant equal 0");
+      }
+      S21FixedMatrix result = Adjugate();
+      result.MulNumber(1.0 / Determinant());
+      return result;
+    } else {
+      return S21FixedMatrix(static_cast<S21Matrix>(*this).InverseMatrix());
+    }
+  }
+
+  constexpr double& operator()(int i, int j) {
+    if (i < 0 || i >= R || j < 0 || j >= C) {
+      throw std::out_of_range("Out of range. Incorrect input");
+    }
+    return matrix_[i * C + j];
+  }
+
+  constexpr double operator()(int i, int j) const {
+    if (i < 0 || i >= R || j < 0 || j >= C) {
+      throw std::out_of_range("Out of range. Incorrect input");
+    }
+    return matrix_[i * C + j];
+  }
+
+  constexpr bool operator==(const S21FixedMatrix& other) const {
+    return EqMatrix(other);
+  }
+
+  constexpr S21FixedMatrix& operator+=(const S21FixedMatrix& other) {
+    SumMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator-=(const S21FixedMatrix& other) {
+    SubMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const S21FixedMatrix<C, C>& other) {
+    MulMatrix(other);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix& operator*=(const double num) {
+    MulNumber(num);
+    return *this;
+  }
+
+  constexpr S21FixedMatrix operator+(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SumMatrix(other);
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator-(const S21FixedMatrix& other) const {
+    S21FixedMatrix result(*this);
+    result.SubMatrix(other);
+    return result;
+  }
+
+  constexpr S21FixedMatrix operator*(const double num) const {
+    S21FixedMatrix result(*this);
+    result.MulNumber(num);
+    return result;
+  }
+
+  template <int K>
+  constexpr S21FixedMatrix<R, K> operator*(
+      const S21FixedMatrix<C, K>& other) const {
+    S21FixedMatrix<R, K> result;
+    for (int i = 0; i < R; i++) {
+      for (int k = 0; k < C; k++) {
+        const double a = matrix_[i * C + k];
+        for (int j = 0; j < K; j++) {
+          result(i, j) += a * other(k, j);
+        }
+      }
+    }
+    return result;
+  }
+
+ private:
+  // Доступ к элементу (i, j) для ядер s21_matrix_small.h
+  constexpr auto Element() const {
+    return [this](int i, int j) { return matrix_[i * C + j]; };
+  }
+
+  // Присоединённая матрица: транспонированная матрица дополнений
+  constexpr S21FixedMatrix Adjugate() const {
+    const auto& a = matrix_;
+    if constexpr (R == 1) {
+      return S21FixedMatrix({1.0});
+    } else if constexpr (R == 2) {
+      return S21FixedMatrix({a[3], -a[1], -a[2], a[0]});
+    } else if constexpr (R == 3) {
+      return S21FixedMatrix({a[4] * a[8] - a[5] * a[7],
+                             a[2] * a[7] - a[1] * a[8],
+                             a[1] * a[5] - a[2] * a[4],
+                             a[5] * a[6] - a[3] * a[8],
+                             a[0] * a[8] - a[2] * a[6],
+                             a[2] * a[3] - a[0] * a[5],
+                             a[3] * a[7] - a[4] * a[6],
+                             a[1] * a[6] - a[0] * a[7],
+                             a[0] * a[4] - a[1] * a[3]});
+    } else {
+      const s21::small_matrix::Minors4<double> m =
+          s21::small_matrix::Pairs4<double>(Element());
+      return S21FixedMatrix({a[5] * m.c5 - a[6] * m.c4 + a[7] * m.c3,
+                             -a[1] * m.c5 + a[2] * m.c4 - a[3] * m.c3,
+                             a[13] * m.s5 - a[14] * m.s4 + a[15] * m.s3,
+                             -a[9] * m.s5 + a[10] * m.s4 - a[11] * m.s3,
+                             -a[4] * m.c5 + a[6] * m.c2 - a[7] * m.c1,
+                             a[0] * m.c5 - a[2] * m.c2 + a[3] * m.c1,
+                             -a[12] * m.s5 + a[14] * m.s2 - a[15] * m.s1,
+                             a[8] * m.s5 - a[10] * m.s2 + a[11] * m.s1,
+                             a[4] * m.c4 - a[5] * m.c2 + a[7] * m.c0,
+                             -a[0] * m.c4 + a[1] * m.c2 - a[3] * m.c0,
+                             a[12] * m.s4 - a[13] * m.s2 + a[15] * m.s0,
+                             -a[8] * m.s4 + a[9] * m.s2 - a[11] * m.s0,
+                             -a[4] * m.c3 + a[5] * m.c1 - a[6] * m.c0,
+                             a[0] * m.c3 - a[1] * m.c1 + a[2] * m.c0,
+                             -a[12] * m.s3 + a[13] * m.s1 - a[14] * m.s0,
+                             a[8] * m.s3 - a[9] * m.s1 + a[10] * m.s0});
+    }
+  }
+
+  std::array<double, R * C> matrix_;
+};
+
+template <int R, int C>
+constexpr S21FixedMatrix<R, C> operator*(double x,
+                                         const S21FixedMatrix<R, C>& y) {
+  return y * x;
+}
+
+#endif  // MATRIX_SRC_S21_FIXED_MATRIX_H
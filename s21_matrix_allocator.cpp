@@ -0,0 +1,183 @@
+#include "s21_matrix_allocator.h"
+
+#include <algorithm>
+#include <new>
+
+namespace {
+
+// Аллокатор новых матриц текущего потока; nullptr — Default()
+thread_local S21MatrixAllocator* tls_current = nullptr;
+
+void* NewBlock(std::size_t bytes) {
+  return ::operator new(bytes,
+                        std::align_val_t(S21MatrixAllocator::kAlignment));
+}
+
+void DeleteBlock(void* block) {
+  ::operator delete(block, std::align_val_t(S21MatrixAllocator::kAlignment));
+}
+
+class DefaultAllocator : public S21MatrixAllocator {
+ public:
+  void* Allocate(std::size_t bytes) override { return NewBlock(bytes); }
+  void Deallocate(void* block, std::size_t) override { DeleteBlock(block); }
+};
+
+/////////////          Кэш пула        /////////////////
+
+// Классы размеров: 2^6 ... 2^19 байт (64 байта ... 512 КБ)
+constexpr int kMinClassShift = 6;
+constexpr int kMaxClassShift = 19;
+constexpr int kClassCount = kMaxClassShift - kMinClassShift + 1;
+// Предел блоков одного класса в кэше потока
+constexpr int kMaxCachedBlocks = 64;
+
+int ClassOf(std::size_t bytes) {
+  for (int shift = kMinClassShift; shift <= kMaxClassShift; shift++) {
+    if (bytes <= (std::size_t(1) << shift)) return shift - kMinClassShift;
+  }
+  return -1;
+}
+
+std::size_t ClassSize(int size_class) {
+  return std::size_t(1) << (size_class + kMinClassShift);
+}
+
+// Свободные блоки связаны в список через свой первый элемент
+struct FreeNode {
+  FreeNode* next;
+};
+
+// Признак того, что кэш потока уже разрушен (при завершении потока
+// могут ещё освобождаться матрицы из других thread_local объектов)
+thread_local bool tls_cache_destroyed = false;
+
+class ThreadCache {
+ public:
+  ~ThreadCache() {
+    Release();
+    tls_cache_destroyed = true;
+  }
+
+  void* Pop(int size_class) {
+    FreeNode* node = heads_[size_class];
+    if (!node) return nullptr;
+    heads_[size_class] = node->next;
+    counts_[size_class]--;
+    return node;
+  }
+
+  bool Push(int size_class, void* block) {
+    if (counts_[size_class] >= kMaxCachedBlocks) return false;
+    FreeNode* node = static_cast<FreeNode*>(block);
+    node->next = heads_[size_class];
+    heads_[size_class] = node;
+    counts_[size_class]++;
+    return true;
+  }
+
+  void Release() {
+    for (int size_class = 0; size_class < kClassCount; size_class++) {
+      while (void* block = Pop(size_class)) DeleteBlock(block);
+    }
+  }
+
+ private:
+  FreeNode* heads_[kClassCount] = {};
+  int counts_[kClassCount] = {};
+};
+
+thread_local ThreadCache tls_cache;
+
+}  // namespace
+
+/////////////          S21MatrixAllocator        /////////////////
+
+S21MatrixAllocator* S21MatrixAllocator::Default() {
+  // Не разрушается: матрицы в статических объектах освобождаются позже
+  static S21MatrixAllocator* instance = new DefaultAllocator;
+  return instance;
+}
+
+S21MatrixAllocator* S21MatrixAllocator::Current() {
+  return tls_current ? tls_current : Default();
+}
+
+void S21MatrixAllocator::SetCurrent(S21MatrixAllocator* allocator) {
+  tls_current = allocator;
+}
+
+/////////////          S21PoolAllocator        /////////////////
+
+S21PoolAllocator* S21PoolAllocator::Instance() {
+  static S21PoolAllocator* instance = new S21PoolAllocator;
+  return instance;
+}
+
+void* S21PoolAllocator::Allocate(std::size_t bytes) {
+  const int size_class = ClassOf(bytes);
+  if (size_class < 0) return NewBlock(bytes);
+  if (!tls_cache_destroyed) {
+    if (void* block = tls_cache.Pop(size_class)) return block;
+  }
+  return NewBlock(ClassSize(size_class));
+}
+
+void S21PoolAllocator::Deallocate(void* block, std::size_t bytes) {
+  const int size_class = ClassOf(bytes);
+  if (size_class >= 0 && !tls_cache_destroyed &&
+      tls_cache.Push(size_class, block)) {
+    return;
+  }
+  DeleteBlock(block);
+}
+
+void S21PoolAllocator::ReleaseThreadCache() {
+  if (!tls_cache_destroyed) tls_cache.Release();
+}
+
+/////////////          S21MatrixArena        /////////////////
+
+S21MatrixArena::S21MatrixArena(std::size_t chunk_bytes)
+    : chunk_bytes_(std::max(chunk_bytes, kAlignment)),
+      offset_(0),
+      used_(0),
+      previous_(tls_current) {
+  tls_current = this;
+}
+
+S21MatrixArena::~S21MatrixArena() {
+  tls_current = previous_;
+  for (const Chunk& chunk : chunks_) {
+    ::operator delete(chunk.data, std::align_val_t(kAlignment));
+  }
+}
+
+void* S21MatrixArena::Allocate(std::size_t bytes) {
+  bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  if (chunks_.empty() || offset_ + bytes > chunks_.back().size) {
+    const std::size_t size = std::max(chunk_bytes_, bytes);
+    chunks_.push_back({static_cast<char*>(::operator new(
+                           size, std::align_val_t(kAlignment))),
+                       size});
+    offset_ = 0;
+  }
+  char* block = chunks_.back().data + offset_;
+  offset_ += bytes;
+  used_ += bytes;
+  return block;
+}
+
+void S21MatrixArena::Deallocate(void* block, std::size_t bytes) {
+  // Последний выделенный блок возвращается сразу — типичный случай для
+  // временных результатов; остальные ждут деструктора
+  bytes = (bytes + kAlignment - 1) / kAlignment * kAlignment;
+  if (!chunks_.empty() &&
+      static_cast<char*>(block) + bytes ==
+          chunks_.back().data + offset_) {
+    offset_ -= bytes;
+    used_ -= bytes;
+  }
+}
+
+std::size_t S21MatrixArena::BytesUsed() const { return used_; }
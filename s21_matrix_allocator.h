@@ -0,0 +1,71 @@
+#ifndef MATRIX_SRC_S21_MATRIX_ALLOCATOR_H
+#define MATRIX_SRC_S21_MATRIX_ALLOCATOR_H
+
+#include <cstddef>
+#include <vector>
+
+// Источник памяти под элементы S21BasicMatrix (размеры — в байтах).
+// Матрица берёт блок у текущего аллокатора своего потока и запоминает,
+// кому его вернуть, поэтому смена аллокатора не затрагивает уже живые
+// матрицы. Блоки выровнены по kAlignment байт.
+class S21MatrixAllocator {
+ public:
+  static constexpr std::size_t kAlignment = 64;
+
+  virtual ~S21MatrixAllocator() = default;
+
+  virtual void* Allocate(std::size_t bytes) = 0;
+  virtual void Deallocate(void* block, std::size_t bytes) = 0;
+
+  // Глобальный operator new / delete с выравниванием
+  static S21MatrixAllocator* Default();
+  // Аллокатор новых матриц в текущем потоке
+  static S21MatrixAllocator* Current();
+  // nullptr возвращает Default()
+  static void SetCurrent(S21MatrixAllocator* allocator);
+};
+
+// Пул блоков по классам размеров (степени двойки) с кэшем на каждый поток.
+// Освобождённый блок остаётся в кэше потока, который его освободил,
+// и отдаётся следующей матрице того же класса без обращения к malloc.
+class S21PoolAllocator : public S21MatrixAllocator {
+ public:
+  static S21PoolAllocator* Instance();
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* block, std::size_t bytes) override;
+
+  // Возвращает кэш текущего потока системе
+  static void ReleaseThreadCache();
+};
+
+// Арена для короткоживущих матриц: пока объект жив, новые матрицы этого
+// потока размещаются последовательно в крупных кусках памяти, освобождение
+// отдельной матрицы ничего не стоит, а вся память возвращается разом в
+// деструкторе. Матрицы из арены не должны её переживать.
+class S21MatrixArena : public S21MatrixAllocator {
+ public:
+  explicit S21MatrixArena(std::size_t chunk_bytes = 1 << 20);
+  S21MatrixArena(const S21MatrixArena&) = delete;
+  S21MatrixArena& operator=(const S21MatrixArena&) = delete;
+  ~S21MatrixArena() override;
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* block, std::size_t bytes) override;
+
+  std::size_t BytesUsed() const;
+
+ private:
+  struct Chunk {
+    char* data;
+    std::size_t size;
+  };
+
+  std::vector<Chunk> chunks_;
+  std::size_t chunk_bytes_;
+  std::size_t offset_;
+  std::size_t used_;
+  S21MatrixAllocator* previous_;
+};
+
+#endif  // MATRIX_SRC_S21_MATRIX_ALLOCATOR_H
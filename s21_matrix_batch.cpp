@@ -0,0 +1,428 @@
+#include "s21_matrix_batch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "s21_matrix_simd.h"
+#include "s21_matrix_small.h"
+#include "s21_thread_pool.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_BATCH_X86 1
+#endif
+
+namespace {
+
+using s21::small_matrix::ClosedDeterminant;
+using s21::small_matrix::IsSingular;
+using s21::small_matrix::Minors4;
+using s21::small_matrix::Pairs4;
+
+template <typename T>
+constexpr int kLanes = S21BasicMatrixBatch<T>::kLanes;
+
+// Шагов ядра (по kLanes матриц) в одной задаче пула
+constexpr int kChunksPerTask = 64;
+
+/////////////          Запуск ядер        /////////////////
+
+// Ядро — функция от номера шага. Оно целиком встраивается (flatten)
+// в функцию запуска, и циклы по kLanes векторизуются под её набор
+// инструкций
+template <typename F>
+__attribute__((flatten)) void RunChunks(const F& kernel, int first, int last) {
+  for (int chunk = first; chunk < last; chunk++) kernel(chunk);
+}
+
+#ifdef S21_BATCH_X86
+template <typename F>
+__attribute__((target("avx2"), flatten)) void RunChunksAvx2(const F& kernel,
+                                                            int first,
+                                                            int last) {
+  for (int chunk = first; chunk < last; chunk++) kernel(chunk);
+}
+
+template <typename F>
+__attribute__((target("avx512f"), flatten)) void RunChunksAvx512(
+    const F& kernel, int first, int last) {
+  for (int chunk = first; chunk < last; chunk++) kernel(chunk);
+}
+#endif  // S21_BATCH_X86
+
+template <typename F>
+void ForEachChunk(int chunks, const F& kernel) {
+  auto run = [&kernel](int first, int last) {
+#ifdef S21_BATCH_X86
+    switch (s21::simd::ActiveIsa()) {
+      case s21::simd::Isa::kAvx512:
+        RunChunksAvx512(kernel, first, last);
+        return;
+      case s21::simd::Isa::kAvx2:
+        RunChunksAvx2(kernel, first, last);
+        return;
+      default:
+        break;
+    }
+#endif
+    RunChunks(kernel, first, last);
+  };
+  const int tasks = (chunks + kChunksPerTask - 1) / kChunksPerTask;
+  S21ThreadPool& pool = S21ThreadPool::Global();
+  if (tasks > 1 && pool.Size() > 1) {
+    pool.ParallelFor(tasks, [&](int task) {
+      run(task * kChunksPerTask,
+          std::min(chunks, (task + 1) * kChunksPerTask));
+    });
+  } else {
+    run(0, chunks);
+  }
+}
+
+// Поштучная обработка матриц крупного порядка, по задаче на блок матриц
+template <typename F>
+void ForEachMatrix(int count, const F& body) {
+  const int per_task = 256;
+  const int tasks = (count + per_task - 1) / per_task;
+  S21ThreadPool::Global().ParallelFor(tasks, [&](int task) {
+    const int last = std::min(count, (task + 1) * per_task);
+    for (int index = task * per_task; index < last; index++) body(index);
+  });
+}
+
+/////////////          Ядра        /////////////////
+
+// Указатели смещены на начало шага; элемент (i, j) матрицы l шага
+// лежит по адресу a[(i * cols + j) * s + l]
+
+template <typename T>
+inline void MulLanes(const T* __restrict a, const T* __restrict b,
+                     T* __restrict c, std::size_t s, int m, int k, int n) {
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      T acc[kLanes<T>] = {};
+      for (int p = 0; p < k; p++) {
+        const T* ap = a + (i * k + p) * s;
+        const T* bp = b + (p * n + j) * s;
+        for (int l = 0; l < kLanes<T>; l++) acc[l] += ap[l] * bp[l];
+      }
+      T* cp = c + (i * n + j) * s;
+      for (int l = 0; l < kLanes<T>; l++) cp[l] = acc[l];
+    }
+  }
+}
+
+// Элементы шага копируются в локальный блок x[i * N + j][l]: так
+// компилятору не нужно доказывать, что входные и выходные плоскости
+// не пересекаются
+template <typename T, int N>
+inline void LoadLanes(const T* a, std::size_t s, T (&x)[N * N][kLanes<T>]) {
+  for (int k = 0; k < N * N; k++) {
+    for (int l = 0; l < kLanes<T>; l++) x[k][l] = a[k * s + l];
+  }
+}
+
+template <typename T, int N>
+inline void DetLanes(const T* a, std::size_t s, T* det) {
+  T x[N * N][kLanes<T>];
+  LoadLanes<T, N>(a, s, x);
+  T d[kLanes<T>];
+  for (int l = 0; l < kLanes<T>; l++) {
+    auto e = [&](int i, int j) { return x[i * N + j][l]; };
+    d[l] = ClosedDeterminant<T, N>(e);
+  }
+  for (int l = 0; l < kLanes<T>; l++) det[l] = d[l];
+}
+
+// Отсев заведомо невырожденных матриц порядка N: если
+// |det| > SingularScreen * max|a_ij|^N, то IsSingular ложно.
+// При частичном выборе |u_kk| <= 2^k * max|a_ij|, поэтому каждый ведущий
+// элемент не меньше |det| / (2^(N(N-1)/2) * max|a_ij|^(N-1)), а правило
+// HasNegligiblePivot сравнивает его с N * eps * max|a_ij|. Слагаемое
+// N! * N покрывает ошибку округления явной формулы определителя,
+// множитель 2 — округление самого разложения
+template <typename T, int N>
+constexpr T SingularScreen() {
+  T factorial = 1;
+  for (int k = 2; k <= N; k++) factorial *= k;
+  return 2 * (T(1 << (N * (N - 1) / 2)) * N + factorial * N) *
+         std::numeric_limits<T>::epsilon();
+}
+
+// Обратная матрица как присоединённая, делённая на определитель.
+// Вырожденность проверяется тем же правилом, что и в S21BasicLU:
+// по всем kLanes матрицам сразу считается отсев SingularScreen, и только
+// не прошедшие его матрицы раскладываются IsSingular по одной
+template <typename T, int N>
+inline void InverseLanes(const T* a, std::size_t s, T* inv,
+                         unsigned char* singular) {
+  T x[N * N][kLanes<T>];
+  LoadLanes<T, N>(a, s, x);
+  T y[N * N][kLanes<T>];
+  T d[kLanes<T>];
+  for (int l = 0; l < kLanes<T>; l++) {
+    auto e = [&](int i, int j) { return x[i * N + j][l]; };
+    auto out = [&](int i, int j, T value) { y[i * N + j][l] = value; };
+    d[l] = ClosedDeterminant<T, N>(e);
+    const T r = T(1) / d[l];
+    if constexpr (N == 1) {
+      out(0, 0, r);
+    } else if constexpr (N == 2) {
+      out(0, 0, e(1, 1) * r);
+      out(0, 1, -e(0, 1) * r);
+      out(1, 0, -e(1, 0) * r);
+      out(1, 1, e(0, 0) * r);
+    } else if constexpr (N == 3) {
+      out(0, 0, (e(1, 1) * e(2, 2) - e(1, 2) * e(2, 1)) * r);
+      out(0, 1, (e(0, 2) * e(2, 1) - e(0, 1) * e(2, 2)) * r);
+      out(0, 2, (e(0, 1) * e(1, 2) - e(0, 2) * e(1, 1)) * r);
+      out(1, 0, (e(1, 2) * e(2, 0) - e(1, 0) * e(2, 2)) * r);
+      out(1, 1, (e(0, 0) * e(2, 2) - e(0, 2) * e(2, 0)) * r);
+      out(1, 2, (e(0, 2) * e(1, 0) - e(0, 0) * e(1, 2)) * r);
+      out(2, 0, (e(1, 0) * e(2, 1) - e(1, 1) * e(2, 0)) * r);
+      out(2, 1, (e(0, 1) * e(2, 0) - e(0, 0) * e(2, 1)) * r);
+      out(2, 2, (e(0, 0) * e(1, 1) - e(0, 1) * e(1, 0)) * r);
+    } else {
+      const Minors4<T> m = Pairs4<T>(e);
+      out(0, 0, (e(1, 1) * m.c5 - e(1, 2) * m.c4 + e(1, 3) * m.c3) * r);
+      out(0, 1, (-e(0, 1) * m.c5 + e(0, 2) * m.c4 - e(0, 3) * m.c3) * r);
+      out(0, 2, (e(3, 1) * m.s5 - e(3, 2) * m.s4 + e(3, 3) * m.s3) * r);
+      out(0, 3, (-e(2, 1) * m.s5 + e(2, 2) * m.s4 - e(2, 3) * m.s3) * r);
+      out(1, 0, (-e(1, 0) * m.c5 + e(1, 2) * m.c2 - e(1, 3) * m.c1) * r);
+      out(1, 1, (e(0, 0) * m.c5 - e(0, 2) * m.c2 + e(0, 3) * m.c1) * r);
+      out(1, 2, (-e(3, 0) * m.s5 + e(3, 2) * m.s2 - e(3, 3) * m.s1) * r);
+      out(1, 3, (e(2, 0) * m.s5 - e(2, 2) * m.s2 + e(2, 3) * m.s1) * r);
+      out(2, 0, (e(1, 0) * m.c4 - e(1, 1) * m.c2 + e(1, 3) * m.c0) * r);
+      out(2, 1, (-e(0, 0) * m.c4 + e(0, 1) * m.c2 - e(0, 3) * m.c0) * r);
+      out(2, 2, (e(3, 0) * m.s4 - e(3, 1) * m.s2 + e(3, 3) * m.s0) * r);
+      out(2, 3, (-e(2, 0) * m.s4 + e(2, 1) * m.s2 - e(2, 3) * m.s0) * r);
+      out(3, 0, (-e(1, 0) * m.c3 + e(1, 1) * m.c1 - e(1, 2) * m.c0) * r);
+      out(3, 1, (e(0, 0) * m.c3 - e(0, 1) * m.c1 + e(0, 2) * m.c0) * r);
+      out(3, 2, (-e(3, 0) * m.s3 + e(3, 1) * m.s1 - e(3, 2) * m.s0) * r);
+      out(3, 3, (e(2, 0) * m.s3 - e(2, 1) * m.s1 + e(2, 2) * m.s0) * r);
+    }
+  }
+  for (int k = 0; k < N * N; k++) {
+    for (int l = 0; l < kLanes<T>; l++) inv[k * s + l] = y[k][l];
+  }
+
+  T bound[kLanes<T>] = {};
+  for (int k = 0; k < N * N; k++) {
+    for (int l = 0; l < kLanes<T>; l++) {
+      bound[l] = std::max(bound[l], std::fabs(x[k][l]));
+    }
+  }
+  bool clear[kLanes<T>];
+  for (int l = 0; l < kLanes<T>; l++) {
+    T power = bound[l];
+    for (int k = 1; k < N; k++) power *= bound[l];
+    // Исчезновение порядка или переполнение степени отсев не пропускает
+    const T limit = SingularScreen<T, N>() * power;
+    clear[l] = std::fabs(d[l]) > limit &&
+               limit >= std::numeric_limits<T>::min() &&
+               limit <= std::numeric_limits<T>::max();
+  }
+  for (int l = 0; l < kLanes<T>; l++) {
+    auto e = [&](int i, int j) { return x[i * N + j][l]; };
+    singular[l] = !clear[l] && IsSingular<T, N>(e);
+  }
+}
+
+template <typename T, int N>
+void DetBatch(const T* a, std::size_t s, T* det) {
+  const int chunks = static_cast<int>(s / kLanes<T>);
+  ForEachChunk(chunks, [=](int chunk) {
+    const std::size_t offset = static_cast<std::size_t>(chunk) * kLanes<T>;
+    DetLanes<T, N>(a + offset, s, det + offset);
+  });
+}
+
+template <typename T, int N>
+void InverseBatch(const T* a, std::size_t s, T* inv,
+                  unsigned char* singular) {
+  const int chunks = static_cast<int>(s / kLanes<T>);
+  ForEachChunk(chunks, [=](int chunk) {
+    const std::size_t offset = static_cast<std::size_t>(chunk) * kLanes<T>;
+    InverseLanes<T, N>(a + offset, s, inv + offset, singular + offset);
+  });
+}
+
+}  // namespace
+
+/////////////          Набор матриц        /////////////////
+
+template <typename T>
+S21BasicMatrixBatch<T>::S21BasicMatrixBatch(int count, int rows, int cols)
+    : count_(count), rows_(rows), cols_(cols) {
+  if (count < 0 || rows <= 0 || cols <= 0) {
+    throw std::out_of_range("Incorrect value");
+  }
+  stride_ = (static_cast<std::size_t>(count) + kLanes - 1) / kLanes * kLanes;
+  data_.assign(stride_ * rows_ * cols_, T(0));
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetCount() const {
+  return count_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMatrixBatch<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+T& S21BasicMatrixBatch<T>::operator()(int index, int i, int j) {
+  if (index < 0 || index >= count_ || i < 0 || i >= rows_ || j < 0 ||
+      j >= cols_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  return Plane(i, j)[index];
+}
+
+template <typename T>
+T S21BasicMatrixBatch<T>::operator()(int index, int i, int j) const {
+  if (index < 0 || index >= count_ || i < 0 || i >= rows_ || j < 0 ||
+      j >= cols_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  return Plane(i, j)[index];
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::SetMatrix(int index,
+                                       const S21BasicMatrix<T>& matrix) {
+  if (matrix.GetRows() != rows_ || matrix.GetCols() != cols_) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      Plane(i, j)[index] = matrix.At(i, j);
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrixBatch<T>::GetMatrix(int index) const {
+  if (index < 0 || index >= count_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  S21BasicMatrix<T> result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      result.At(i, j) = Plane(i, j)[index];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+void S21BasicMatrixBatch<T>::MulMatrix(const S21BasicMatrixBatch& other) {
+  if (count_ != other.count_) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
+  }
+  const int m = rows_, k = cols_, n = other.cols_;
+  const std::size_t s = stride_;
+  std::vector<T> result(s * m * n);
+  const T* a = data_.data();
+  const T* b = other.data_.data();
+  T* c = result.data();
+  ForEachChunk(static_cast<int>(s / kLanes), [=](int chunk) {
+    const std::size_t offset = static_cast<std::size_t>(chunk) * kLanes;
+    MulLanes(a + offset, b + offset, c + offset, s, m, k, n);
+  });
+  data_.swap(result);
+  cols_ = n;
+}
+
+template <typename T>
+std::vector<T> S21BasicMatrixBatch<T>::Determinant() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix isn't square");
+  }
+  std::vector<T> det(stride_);
+  switch (rows_) {
+    case 1:
+      DetBatch<T, 1>(data_.data(), stride_, det.data());
+      break;
+    case 2:
+      DetBatch<T, 2>(data_.data(), stride_, det.data());
+      break;
+    case 3:
+      DetBatch<T, 3>(data_.data(), stride_, det.data());
+      break;
+    case 4:
+      DetBatch<T, 4>(data_.data(), stride_, det.data());
+      break;
+    default:
+      ForEachMatrix(count_, [&](int index) {
+        det[index] = S21BasicLU<T>(GetMatrix(index)).Determinant();
+      });
+  }
+  det.resize(count_);
+  return det;
+}
+
+template <typename T>
+S21BasicMatrixBatch<T> S21BasicMatrixBatch<T>::InverseMatrix() const {
+  if (rows_ != cols_) {
+    throw std::invalid_argument("Matrix isn't square");
+  }
+  S21BasicMatrixBatch result(count_, rows_, cols_);
+  if (rows_ > 4) {
+    ForEachMatrix(count_, [&](int index) {
+      result.SetMatrix(index, S21BasicLU<T>(GetMatrix(index)).Inverse());
+    });
+    return result;
+  }
+
+  std::vector<unsigned char> singular(stride_);
+  const T* a = data_.data();
+  T* inv = result.data_.data();
+  switch (rows_) {
+    case 1:
+      InverseBatch<T, 1>(a, stride_, inv, singular.data());
+      break;
+    case 2:
+      InverseBatch<T, 2>(a, stride_, inv, singular.data());
+      break;
+    case 3:
+      InverseBatch<T, 3>(a, stride_, inv, singular.data());
+      break;
+    default:
+      InverseBatch<T, 4>(a, stride_, inv, singular.data());
+  }
+  // Дополнение набора до kLanes не проверяется
+  for (int index = 0; index < count_; index++) {
+    if (singular[index]) {
+      throw std::out_of_range("Determenant equal 0");
+    }
+  }
+  return result;
+}
+
+template <typename T>
+const T* S21BasicMatrixBatch<T>::Plane(int i, int j) const {
+  return data_.data() + static_cast<std::size_t>(i * cols_ + j) * stride_;
+}
+
+template <typename T>
+T* S21BasicMatrixBatch<T>::Plane(int i, int j) {
+  return data_.data() + static_cast<std::size_t>(i * cols_ + j) * stride_;
+}
+
+template class S21BasicMatrixBatch<float>;
+template class S21BasicMatrixBatch<double>;
+template class S21BasicMatrixBatch<long double>;
@@ -0,0 +1,52 @@
+#ifndef MATRIX_SRC_S21_MATRIX_BATCH_H
+#define MATRIX_SRC_S21_MATRIX_BATCH_H
+
+#include <cstddef>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Набор из count матриц одного размера rows x cols в раскладке
+// «структура массивов»: элемент (i, j) всех матриц набора лежит подряд,
+// data[(i * cols + j) * stride + index]. Ядра обрабатывают сразу по
+// kLanes матриц одной векторной инструкцией, а крупные наборы делятся
+// между потоками S21ThreadPool::Global().
+// Определитель и обратная матрица для порядка до 4 считаются явными
+// формулами по всему набору, для больших порядков — LU-разложением каждой
+// матрицы отдельно.
+template <typename T>
+class S21BasicMatrixBatch {
+ public:
+  // Число матриц, обрабатываемых ядром за один шаг
+  static constexpr int kLanes = static_cast<int>(64 / sizeof(T));
+
+  S21BasicMatrixBatch(int count, int rows, int cols);
+
+  int GetCount() const;
+  int GetRows() const;
+  int GetCols() const;
+
+  // Элемент (i, j) матрицы index
+  T& operator()(int index, int i, int j);
+  T operator()(int index, int i, int j) const;
+  void SetMatrix(int index, const S21BasicMatrix<T>& matrix);
+  S21BasicMatrix<T> GetMatrix(int index) const;
+
+  // Попарное произведение: матрица index умножается на other[index]
+  void MulMatrix(const S21BasicMatrixBatch& other);
+  std::vector<T> Determinant() const;
+  S21BasicMatrixBatch InverseMatrix() const;
+
+ private:
+  const T* Plane(int i, int j) const;
+  T* Plane(int i, int j);
+
+  int count_, rows_, cols_;
+  // Длина одной плоскости элемента: count_, дополненное до кратного kLanes
+  std::size_t stride_;
+  std::vector<T> data_;
+};
+
+using S21MatrixBatch = S21BasicMatrixBatch<double>;
+
+#endif  // MATRIX_SRC_S21_MATRIX_BATCH_H
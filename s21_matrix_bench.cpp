@@ -0,0 +1,295 @@
+#include <benchmark/benchmark.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_sparse.h"
+#include "s21_matrix_stream.h"
+
+// Замеры всех операций S21Matrix на размерах от 2 до 2048.
+// make bench печатает таблицу и сохраняет результаты в bench.json;
+// два таких файла сравниваются скриптом tools/compare.py из Google
+// Benchmark: compare.py benchmarks old.json new.json
+
+namespace {
+
+constexpr int kMinSize = 2;
+constexpr int kMaxSize = 2048;
+// Прежний тройной цикл i-j-k, с которым сравнивается блочный MulMatrix
+constexpr int kMaxNaiveSize = 1024;
+
+template <typename T>
+S21BasicMatrix<T> Filled(int n, unsigned seed) {
+  S21BasicMatrix<T> m(n, n);
+  for (int i = 0; i < n; i++) {
+    for (T& x : m.Row(i)) {
+      seed = seed * 1103515245u + 12345u;
+      x = static_cast<T>(seed % 2001) / 1000 - 1;
+    }
+  }
+  return m;
+}
+
+// Число операций за итерацию как скорость: FLOP/s в выводе и JSON
+void SetFlops(benchmark::State& state, double flops) {
+  state.counters["FLOP/s"] =
+      benchmark::Counter(flops, benchmark::Counter::kIsIterationInvariantRate);
+}
+
+template <typename T>
+void SetBytes(benchmark::State& state, int n, int matrices) {
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * n * n *
+                          matrices * static_cast<int64_t>(sizeof(T)));
+}
+
+// Сбрасывает файл на диск и вытесняет его страницы из кэша, чтобы
+// следующее чтение шло с диска, а не из памяти
+void DropCache(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) return;
+  ::fdatasync(fd);
+  ::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+  ::close(fd);
+}
+
+/////////////          Создание и копирование        /////////////////
+
+void BM_Construct(benchmark::State& state) {
+  const int n = state.range(0);
+  for (auto _ : state) {
+    S21Matrix m(n, n);
+    benchmark::DoNotOptimize(m);
+  }
+}
+
+void BM_Copy(benchmark::State& state) {
+  const int n = state.range(0);
+  const S21Matrix a = Filled<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix copy(a);
+    benchmark::DoNotOptimize(copy);
+  }
+  SetBytes<double>(state, n, 2);
+}
+
+void BM_Move(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix moved(std::move(a));
+    a = std::move(moved);
+    benchmark::DoNotOptimize(a);
+  }
+}
+
+/////////////          Поэлементные операции        /////////////////
+
+void BM_SumMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled<double>(n, 1);
+  const S21Matrix b = Filled<double>(n, 2);
+  for (auto _ : state) {
+    a.SumMatrix(b);
+    benchmark::ClobberMemory();
+  }
+  SetBytes<double>(state, n, 3);
+}
+
+void BM_MulNumber(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled<double>(n, 1);
+  for (auto _ : state) {
+    a.MulNumber(-1.0);
+    benchmark::ClobberMemory();
+  }
+  SetBytes<double>(state, n, 2);
+}
+
+void BM_Transpose(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix t = a.Transpose();
+    benchmark::DoNotOptimize(t);
+  }
+  SetBytes<double>(state, n, 2);
+}
+
+/////////////          Умножение        /////////////////
+
+template <typename T>
+void BM_MulMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  const S21BasicMatrix<T> a = Filled<T>(n, 1);
+  const S21BasicMatrix<T> b = Filled<T>(n, 2);
+  for (auto _ : state) {
+    S21BasicMatrix<T> c = a;
+    c.MulMatrix(b);
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+
+// Та же скорость в пересчёте на 2n^3 операций классического алгоритма
+void BM_MulMatrixStrassen(benchmark::State& state) {
+  const int n = state.range(0);
+  const S21Matrix a = Filled<double>(n, 1);
+  const S21Matrix b = Filled<double>(n, 2);
+  for (auto _ : state) {
+    S21Matrix c = a;
+    c.MulMatrixStrassen(b);
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+
+void NaiveMul(int n, const std::vector<double>& a, const std::vector<double>& b,
+              std::vector<double>& c) {
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum = 0;
+      for (int k = 0; k < n; k++) {
+        sum += a[i * n + k] * b[k * n + j];
+      }
+      c[i * n + j] = sum;
+    }
+  }
+}
+
+void BM_NaiveMulMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  const S21Matrix a = Filled<double>(n, 1);
+  const S21Matrix b = Filled<double>(n, 2);
+  std::vector<double> fa(a.Data(), a.Data() + n * n);
+  std::vector<double> fb(b.Data(), b.Data() + n * n), fc(n * n);
+  for (auto _ : state) {
+    NaiveMul(n, fa, fb, fc);
+    benchmark::DoNotOptimize(fc.data());
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+
+// Разреженная матрица с 1% ненулевых элементов на плотную; FLOP/s
+// считаются по фактически выполненным 2 * nnz * n операциям
+void BM_SparseMulMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a(n, n);
+  unsigned seed = 1;
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      seed = seed * 1103515245u + 12345u;
+      if ((seed >> 16) % 100 == 0) a.At(i, j) = 1.0 + (seed >> 8) % 7;
+    }
+  }
+  const S21SparseMatrix sparse(a);
+  const S21Matrix b = Filled<double>(n, 2);
+  for (auto _ : state) {
+    S21Matrix c = sparse * b;
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlops(state, 2.0 * sparse.GetNonZeros() * n);
+}
+
+// Умножение по файлам с бюджетом памяти в половину одного операнда.
+// Перед каждой итерацией страницы A, B и прежнего C вытесняются из кэша
+// вне замера, поэтому bytes_per_second — скорость чтения и записи
+// с диска, а не из памяти; io_wait — доля времени, когда вычисления
+// ждали чтения
+void BM_MulMatrixFiles(benchmark::State& state) {
+  const int n = state.range(0);
+  const std::string a_path = "bench_a.bin", b_path = "bench_b.bin",
+                    c_path = "bench_c.bin";
+  Filled<double>(n, 1).Save(a_path);
+  Filled<double>(n, 2).Save(b_path);
+  s21::io::StreamOptions options;
+  options.memory_budget = static_cast<std::size_t>(n) * n * sizeof(double) / 2;
+  std::uint64_t bytes = 0;
+  double io_wait = 0, seconds = 0;
+  for (auto _ : state) {
+    state.PauseTiming();
+    DropCache(a_path);
+    DropCache(b_path);
+    DropCache(c_path);
+    state.ResumeTiming();
+    const s21::io::StreamStats stats =
+        s21::io::MulMatrixFiles<double>(a_path, b_path, c_path, options);
+    bytes += stats.bytes_read + stats.bytes_written;
+    io_wait += stats.io_wait_seconds;
+    seconds += stats.seconds;
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(bytes));
+  state.counters["io_wait"] = seconds > 0 ? io_wait / seconds : 0;
+  SetFlops(state, 2.0 * n * n * n);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+/////////////          Определитель и обратная матрица        /////////////////
+
+void BM_Determinant(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled<double>(n, 1);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(a.Determinant());
+  }
+  SetFlops(state, 2.0 / 3 * n * n * n);
+}
+
+void BM_CalcComplements(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix c = a.CalcComplements();
+    benchmark::DoNotOptimize(c);
+  }
+  SetFlops(state, 8.0 / 3 * n * n * n);
+}
+
+void BM_InverseMatrix(benchmark::State& state) {
+  const int n = state.range(0);
+  S21Matrix a = Filled<double>(n, 1);
+  for (auto _ : state) {
+    S21Matrix inv = a.InverseMatrix();
+    benchmark::DoNotOptimize(inv);
+  }
+  SetFlops(state, 2.0 * n * n * n);
+}
+
+void Sizes(benchmark::internal::Benchmark* b, int max_size) {
+  b->RangeMultiplier(2)->Range(kMinSize, max_size);
+  b->Unit(benchmark::kMicrosecond);
+}
+
+void AllSizes(benchmark::internal::Benchmark* b) { Sizes(b, kMaxSize); }
+
+}  // namespace
+
+BENCHMARK(BM_Construct)->Apply(AllSizes);
+BENCHMARK(BM_Copy)->Apply(AllSizes);
+BENCHMARK(BM_Move)->Apply(AllSizes);
+BENCHMARK(BM_SumMatrix)->Apply(AllSizes);
+BENCHMARK(BM_MulNumber)->Apply(AllSizes);
+BENCHMARK(BM_Transpose)->Apply(AllSizes);
+BENCHMARK(BM_MulMatrix<double>)->Apply(AllSizes);
+BENCHMARK(BM_MulMatrix<float>)->Apply(AllSizes);
+BENCHMARK(BM_MulMatrixStrassen)->Apply(AllSizes);
+BENCHMARK(BM_NaiveMulMatrix)->Apply([](benchmark::internal::Benchmark* b) {
+  Sizes(b, kMaxNaiveSize);
+});
+BENCHMARK(BM_SparseMulMatrix)->Apply(AllSizes);
+BENCHMARK(BM_MulMatrixFiles)
+    ->RangeMultiplier(2)
+    ->Range(256, kMaxSize)
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+BENCHMARK(BM_Determinant)->Apply(AllSizes);
+BENCHMARK(BM_CalcComplements)->Apply(AllSizes);
+BENCHMARK(BM_InverseMatrix)->Apply(AllSizes);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,160 @@
+#ifndef MATRIX_SRC_S21_MATRIX_EXPR_H
+#define MATRIX_SRC_S21_MATRIX_EXPR_H
+
+#include <stdexcept>
+#include <type_traits>
+
+// Ленивые поэлементные выражения над матрицами.
+// Операторы +, - и умножение на число возвращают узел выражения, а не
+// матрицу; всё выражение вычисляется за один проход при присваивании в
+// S21Matrix или при её конструировании. Узлы держат матрицы-операнды по
+// ссылке, поэтому выражение нельзя сохранять дольше полного выражения
+// (например, в auto-переменную).
+// Узел принимают операторы * и == из s21_matrix_oop.h, а методы
+// S21Matrix без изменения матрицы ((A + B).Determinant()) вызываются
+// у значения узла Eval().
+// Каждый тип выражения объявляет kMayAlias: может ли он читать элементы
+// приёмника не в той же позиции (окна S21MatrixView). Такие выражения
+// сначала вычисляются во временную матрицу.
+// Тип элементов узла — value_type его операндов; смешивать матрицы
+// разных типов в одном выражении нельзя.
+
+template <typename T>
+class S21BasicMatrix;
+
+template <typename E>
+class S21MatrixExpr {
+ public:
+  int Rows() const { return Self().ExprRows(); }
+  int Cols() const { return Self().ExprCols(); }
+  auto Eval(int i, int j) const { return Self().ExprEval(i, j); }
+
+  const E& Self() const { return static_cast<const E&>(*this); }
+};
+
+// Узел выражения: методы S21Matrix, не меняющие матрицу, вычисляют
+// выражение во временную матрицу и вызываются у неё
+template <typename E>
+class S21MatrixExprNode : public S21MatrixExpr<E> {
+ public:
+  using S21MatrixExpr<E>::Eval;
+  auto Eval() const {
+    return S21BasicMatrix<typename E::value_type>(this->Self());
+  }
+
+  int GetRows() const { return this->Rows(); }
+  int GetCols() const { return this->Cols(); }
+  auto operator()(int i, int j) const {
+    if (i < 0 || i >= this->Rows() || j < 0 || j >= this->Cols()) {
+      throw std::out_of_range("Out of range. Incorrect input");
+    }
+    return Eval(i, j);
+  }
+  template <typename M>
+  bool EqMatrix(const M& other) const {
+    return Eval() == other;
+  }
+  auto Transpose() const { return Eval().Transpose(); }
+  auto CalcComplements() const { return Eval().CalcComplements(); }
+  auto Determinant() const { return Eval().Determinant(); }
+  auto InverseMatrix() const { return Eval().InverseMatrix(); }
+};
+
+// Матрицы хранятся в узлах по ссылке, вложенные узлы — по значению
+template <typename E>
+struct S21ExprOperand {
+  using type = const E;
+};
+
+template <typename T>
+struct S21ExprOperand<S21BasicMatrix<T>> {
+  using type = const S21BasicMatrix<T>&;
+};
+
+struct S21ExprPlus {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a + b;
+  }
+};
+
+struct S21ExprMinus {
+  template <typename T>
+  static T Apply(T a, T b) {
+    return a - b;
+  }
+};
+
+template <typename L, typename R, typename Op>
+class S21MatrixBinaryExpr
+    : public S21MatrixExprNode<S21MatrixBinaryExpr<L, R, Op>> {
+ public:
+  using value_type = typename L::value_type;
+  static_assert(std::is_same<value_type, typename R::value_type>::value,
+                "Element types of matrices are different");
+  static constexpr bool kMayAlias = L::kMayAlias || R::kMayAlias;
+
+  S21MatrixBinaryExpr(const L& left, const R& right)
+      : left_(left), right_(right) {
+    if (left.Rows() != right.Rows() || left.Cols() != right.Cols()) {
+      throw std::invalid_argument("Sizes of matrices are different");
+    }
+  }
+
+  int ExprRows() const { return left_.Rows(); }
+  int ExprCols() const { return left_.Cols(); }
+  value_type ExprEval(int i, int j) const {
+    return Op::Apply(left_.Eval(i, j), right_.Eval(i, j));
+  }
+
+ private:
+  typename S21ExprOperand<L>::type left_;
+  typename S21ExprOperand<R>::type right_;
+};
+
+template <typename E>
+class S21MatrixScaledExpr
+    : public S21MatrixExprNode<S21MatrixScaledExpr<E>> {
+ public:
+  using value_type = typename E::value_type;
+  static constexpr bool kMayAlias = E::kMayAlias;
+
+  S21MatrixScaledExpr(const E& operand, value_type factor)
+      : operand_(operand), factor_(factor) {}
+
+  int ExprRows() const { return operand_.Rows(); }
+  int ExprCols() const { return operand_.Cols(); }
+  value_type ExprEval(int i, int j) const {
+    return operand_.Eval(i, j) * factor_;
+  }
+
+ private:
+  typename S21ExprOperand<E>::type operand_;
+  value_type factor_;
+};
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21ExprPlus> operator+(const S21MatrixExpr<L>& x,
+                                                 const S21MatrixExpr<R>& y) {
+  return S21MatrixBinaryExpr<L, R, S21ExprPlus>(x.Self(), y.Self());
+}
+
+template <typename L, typename R>
+S21MatrixBinaryExpr<L, R, S21ExprMinus> operator-(const S21MatrixExpr<L>& x,
+                                                  const S21MatrixExpr<R>& y) {
+  return S21MatrixBinaryExpr<L, R, S21ExprMinus>(x.Self(), y.Self());
+}
+
+template <typename E>
+S21MatrixScaledExpr<E> operator*(const S21MatrixExpr<E>& x,
+                                 typename E::value_type y) {
+  return S21MatrixScaledExpr<E>(x.Self(), y);
+}
+
+template <typename E>
+S21MatrixScaledExpr<E> operator*(typename E::value_type x,
+                                 const S21MatrixExpr<E>& y) {
+  return S21MatrixScaledExpr<E>(y.Self(), x);
+}
+
+#endif  // MATRIX_SRC_S21_MATRIX_EXPR_H
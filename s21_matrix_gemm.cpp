@@ -0,0 +1,351 @@
+#include "s21_matrix_gemm.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "s21_thread_pool.h"
+
+namespace s21 {
+
+namespace {
+
+// Размеры регистрового блока и блоков кэша.
+// kMr x kNr аккумуляторов помещаются в векторные регистры (строка
+// полосы B из kNr элементов занимает одну строку кэша, поэтому для float
+// она вдвое шире, чем для double), упакованная панель A (kMc x kKc) —
+// в L2, панель B (kKc x kNc) — в L3.
+constexpr int kMr = 4;
+template <typename T>
+constexpr int kNr = static_cast<int>(64 / sizeof(T));
+constexpr int kKc = 256;
+constexpr int kMc = 128;
+constexpr int kNc = 2048;
+
+// Ниже этого числа умножений упаковка не окупается
+constexpr long kSmallProduct = 32L * 32L * 32L;
+// Ниже этого числа умножений распределение по потокам не окупается
+constexpr long kParallelProduct = 128L * 128L * 128L;
+
+constexpr std::size_t kPackAlignment = 64;
+
+// Буфер упаковки, переиспользуемый между вызовами в пределах потока
+template <typename T>
+class PackBuffer {
+ public:
+  PackBuffer() = default;
+  PackBuffer(const PackBuffer&) = delete;
+  PackBuffer& operator=(const PackBuffer&) = delete;
+  ~PackBuffer() { Release(); }
+
+  T* Get(std::size_t count) {
+    if (count > size_) {
+      Release();
+      data_ = static_cast<T*>(::operator new(
+          count * sizeof(T), std::align_val_t(kPackAlignment)));
+      size_ = count;
+    }
+    return data_;
+  }
+
+ private:
+  void Release() {
+    if (data_) {
+      ::operator delete(data_, std::align_val_t(kPackAlignment));
+      data_ = nullptr;
+      size_ = 0;
+    }
+  }
+
+  T* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+
+// Упаковка блока A (mc x kc) в полосы по kMr строк: внутри полосы
+// элементы идут столбец за столбцом, неполная полоса дополняется нулями.
+template <typename T>
+void PackA(int mc, int kc, const T* a, Stride a_rs, Stride a_cs, T* ap) {
+  for (int i0 = 0; i0 < mc; i0 += kMr) {
+    const int mr = std::min(kMr, mc - i0);
+    for (int p = 0; p < kc; p++) {
+      for (int i = 0; i < mr; i++) {
+        ap[i] = a[(i0 + i) * a_rs + p * a_cs];
+      }
+      for (int i = mr; i < kMr; i++) {
+        ap[i] = T(0);
+      }
+      ap += kMr;
+    }
+  }
+}
+
+// Упаковка блока B (kc x nc) в полосы по kNr столбцов: внутри полосы
+// элементы идут строка за строкой, неполная полоса дополняется нулями.
+template <typename T>
+void PackB(int kc, int nc, const T* b, Stride b_rs, Stride b_cs, T* bp) {
+  for (int j0 = 0; j0 < nc; j0 += kNr<T>) {
+    const int nr = std::min(kNr<T>, nc - j0);
+    for (int p = 0; p < kc; p++) {
+      const T* row = b + p * b_rs + j0 * b_cs;
+      for (int j = 0; j < nr; j++) {
+        bp[j] = row[j * b_cs];
+      }
+      for (int j = nr; j < kNr<T>; j++) {
+        bp[j] = T(0);
+      }
+      bp += kNr<T>;
+    }
+  }
+}
+
+// Регистровое микроядро: C(mr x nr) += Ap(kMr x kc) * Bp(kc x kNr)
+template <typename T>
+void MicroKernel(int kc, const T* ap, const T* bp, T* c, Stride c_rs, int mr,
+                 int nr) {
+  T acc[kMr][kNr<T>] = {};
+  for (int p = 0; p < kc; p++) {
+    for (int i = 0; i < kMr; i++) {
+      const T ai = ap[i];
+      for (int j = 0; j < kNr<T>; j++) {
+        acc[i][j] += ai * bp[j];
+      }
+    }
+    ap += kMr;
+    bp += kNr<T>;
+  }
+  for (int i = 0; i < mr; i++) {
+    for (int j = 0; j < nr; j++) {
+      c[i * c_rs + j] += acc[i][j];
+    }
+  }
+}
+
+// Макроядро: проход микроядром по упакованным панелям mc x nc
+template <typename T>
+void MacroKernel(int mc, int nc, int kc, const T* ap, const T* bp, T* c,
+                 Stride c_rs) {
+  for (int j0 = 0; j0 < nc; j0 += kNr<T>) {
+    const int nr = std::min(kNr<T>, nc - j0);
+    const T* b_strip = bp + static_cast<std::size_t>(j0) * kc;
+    for (int i0 = 0; i0 < mc; i0 += kMr) {
+      const int mr = std::min(kMr, mc - i0);
+      MicroKernel(kc, ap + static_cast<std::size_t>(i0) * kc, b_strip,
+                  c + i0 * c_rs + j0, c_rs, mr, nr);
+    }
+  }
+}
+
+// Прямой цикл i-p-j для маленьких произведений
+template <typename T>
+void SmallGemm(int m, int n, int k, const T* a, Stride a_rs, Stride a_cs,
+               const T* b, Stride b_rs, Stride b_cs, T* c, Stride c_rs) {
+  for (int i = 0; i < m; i++) {
+    T* c_row = c + i * c_rs;
+    for (int p = 0; p < k; p++) {
+      const T aip = a[i * a_rs + p * a_cs];
+      const T* b_row = b + p * b_rs;
+      for (int j = 0; j < n; j++) {
+        c_row[j] += aip * b_row[j * b_cs];
+      }
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void Gemm(int m, int n, int k, const T* a, Stride a_rs, Stride a_cs, const T* b,
+          Stride b_rs, Stride b_cs, T* c, Stride c_rs) {
+  if (m <= 0 || n <= 0 || k <= 0) return;
+  if (static_cast<long>(m) * n * k <= kSmallProduct) {
+    SmallGemm(m, n, k, a, a_rs, a_cs, b, b_rs, b_cs, c, c_rs);
+    return;
+  }
+
+  S21ThreadPool& pool = S21ThreadPool::Global();
+  const bool parallel =
+      pool.Size() > 1 && static_cast<long>(m) * n * k >= kParallelProduct;
+
+  thread_local PackBuffer<T> b_buffer;
+  const int kc_max = std::min(k, kKc);
+  const int nc_max = (std::min(n, kNc) + kNr<T> - 1) / kNr<T> * kNr<T>;
+  T* bp = b_buffer.Get(static_cast<std::size_t>(kc_max) * nc_max);
+
+  for (int jc = 0; jc < n; jc += kNc) {
+    const int nc = std::min(kNc, n - jc);
+    for (int pc = 0; pc < k; pc += kKc) {
+      const int kc = std::min(kKc, k - pc);
+      PackB(kc, nc, b + pc * b_rs + jc * b_cs, b_rs, b_cs, bp);
+
+      // Задача — блок строк kMc и часть столбцов панели B, кратная kNr.
+      // Каждый элемент C считается одной задачей в одном и том же порядке,
+      // поэтому результат не зависит от числа потоков.
+      const int m_blocks = (m + kMc - 1) / kMc;
+      const int n_strips = (nc + kNr<T> - 1) / kNr<T>;
+      int n_parts = 1;
+      if (parallel && m_blocks < pool.Size()) {
+        n_parts = std::min(n_strips, (pool.Size() + m_blocks - 1) / m_blocks);
+      }
+      const int strips_per_part = (n_strips + n_parts - 1) / n_parts;
+      n_parts = (n_strips + strips_per_part - 1) / strips_per_part;
+
+      auto task = [&](int index) {
+        thread_local PackBuffer<T> a_buffer;
+        const int ic = (index / n_parts) * kMc;
+        const int mc = std::min(kMc, m - ic);
+        const int j0 = (index % n_parts) * strips_per_part * kNr<T>;
+        const int nr = std::min(strips_per_part * kNr<T>, nc - j0);
+        const int mc_padded = (mc + kMr - 1) / kMr * kMr;
+        T* ap = a_buffer.Get(static_cast<std::size_t>(mc_padded) * kc);
+        PackA(mc, kc, a + ic * a_rs + pc * a_cs, a_rs, a_cs, ap);
+        MacroKernel(mc, nr, kc, ap, bp + static_cast<std::size_t>(j0) * kc,
+                    c + ic * c_rs + jc + j0, c_rs);
+      };
+      const int tasks = m_blocks * n_parts;
+      if (parallel) {
+        pool.ParallelFor(tasks, task);
+      } else {
+        for (int index = 0; index < tasks; index++) task(index);
+      }
+    }
+  }
+}
+
+/////////////          Штрассен–Виноград        /////////////////
+
+namespace {
+
+// dst = x + sign * y для блоков rows x cols
+template <typename T>
+void Combine(int rows, int cols, const T* x, Stride x_rs, const T* y,
+             Stride y_rs, T sign, T* dst, Stride dst_rs) {
+  for (int i = 0; i < rows; i++) {
+    const T* x_row = x + i * x_rs;
+    const T* y_row = y + i * y_rs;
+    T* dst_row = dst + i * dst_rs;
+    for (int j = 0; j < cols; j++) dst_row[j] = x_row[j] + sign * y_row[j];
+  }
+}
+
+// C = A * B через Gemm, который прибавляет к C
+template <typename T>
+void Overwrite(int m, int n, int k, const T* a, Stride a_rs, const T* b,
+               Stride b_rs, T* c, Stride c_rs) {
+  for (int i = 0; i < m; i++) std::fill(c + i * c_rs, c + i * c_rs + n, T(0));
+  Gemm(m, n, k, a, a_rs, 1, b, b_rs, 1, c, c_rs);
+}
+
+}  // namespace
+
+int StrassenDepth(int m, int n, int k, int threshold) {
+  int depth = 0;
+  threshold = std::max(threshold, 2);
+  while (std::min(std::min(m, n), k) >= threshold) {
+    m /= 2;
+    n /= 2;
+    k /= 2;
+    depth++;
+  }
+  return depth;
+}
+
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T* a, Stride a_rs, const T* b,
+                  Stride b_rs, T* c, Stride c_rs, int threshold) {
+  if (m <= 0 || n <= 0) return;
+  if (std::min(std::min(m, n), k) < std::max(threshold, 2)) {
+    Overwrite(m, n, k, a, a_rs, b, b_rs, c, c_rs);
+    return;
+  }
+
+  const int m2 = m / 2, n2 = n / 2, k2 = k / 2;
+  const T* a11 = a;
+  const T* a12 = a + k2;
+  const T* a21 = a + m2 * a_rs;
+  const T* a22 = a21 + k2;
+  const T* b11 = b;
+  const T* b12 = b + n2;
+  const T* b21 = b + k2 * b_rs;
+  const T* b22 = b21 + n2;
+  T* c11 = c;
+  T* c12 = c + n2;
+  T* c21 = c + m2 * c_rs;
+  T* c22 = c21 + n2;
+
+  // s, t — суммы блоков A и B, p, u — промежуточные произведения
+  std::vector<T> s_buf(static_cast<std::size_t>(m2) * k2);
+  std::vector<T> t_buf(static_cast<std::size_t>(k2) * n2);
+  std::vector<T> p_buf(static_cast<std::size_t>(m2) * n2);
+  std::vector<T> u_buf(static_cast<std::size_t>(m2) * n2);
+  T* s = s_buf.data();
+  T* t = t_buf.data();
+  T* p = p_buf.data();
+  T* u = u_buf.data();
+  auto mul = [&](const T* x, Stride x_rs, const T* y, Stride y_rs, T* z,
+                 Stride z_rs) {
+    StrassenGemm(m2, n2, k2, x, x_rs, y, y_rs, z, z_rs, threshold);
+  };
+
+  // p = M1 = A11 B11, C11 = M1 + M2
+  mul(a11, a_rs, b11, b_rs, p, n2);
+  mul(a12, a_rs, b21, b_rs, c11, c_rs);
+  Combine(m2, n2, c11, c_rs, p, n2, T(1), c11, c_rs);
+  // C22 = M5 = S1 T1, S1 = A21 + A22, T1 = B12 - B11
+  Combine(m2, k2, a21, a_rs, a22, a_rs, T(1), s, k2);
+  Combine(k2, n2, b12, b_rs, b11, b_rs, T(-1), t, n2);
+  mul(s, k2, t, n2, c22, c_rs);
+  // C12 = M6 = S2 T2, S2 = S1 - A11, T2 = B22 - T1; p = U2 = M1 + M6
+  Combine(m2, k2, s, k2, a11, a_rs, T(-1), s, k2);
+  Combine(k2, n2, b22, b_rs, t, n2, T(-1), t, n2);
+  mul(s, k2, t, n2, c12, c_rs);
+  Combine(m2, n2, p, n2, c12, c_rs, T(1), p, n2);
+  // C12 = M3 + U2 + M5, M3 = S4 B22, S4 = A12 - S2
+  Combine(m2, k2, a12, a_rs, s, k2, T(-1), s, k2);
+  mul(s, k2, b22, b_rs, c12, c_rs);
+  Combine(m2, n2, c12, c_rs, p, n2, T(1), c12, c_rs);
+  Combine(m2, n2, c12, c_rs, c22, c_rs, T(1), c12, c_rs);
+  // C21 = M4 = A22 T4, T4 = T2 - B21
+  Combine(k2, n2, t, n2, b21, b_rs, T(-1), t, n2);
+  mul(a22, a_rs, t, n2, c21, c_rs);
+  // u = M7 = S3 T3, S3 = A11 - A21, T3 = B22 - B12; p = U3 = U2 + M7
+  Combine(m2, k2, a11, a_rs, a21, a_rs, T(-1), s, k2);
+  Combine(k2, n2, b22, b_rs, b12, b_rs, T(-1), t, n2);
+  mul(s, k2, t, n2, u, n2);
+  Combine(m2, n2, p, n2, u, n2, T(1), p, n2);
+  // C21 = U3 - M4, C22 = U3 + M5
+  Combine(m2, n2, p, n2, c21, c_rs, T(-1), c21, c_rs);
+  Combine(m2, n2, c22, c_rs, p, n2, T(1), c22, c_rs);
+
+  // Отщеплённые нечётные размеры
+  if (k % 2) {
+    Gemm(2 * m2, 2 * n2, 1, a + 2 * k2, a_rs, 1, b + 2 * k2 * b_rs, b_rs, 1,
+         c, c_rs);
+  }
+  if (n % 2) {
+    Overwrite(2 * m2, 1, k, a, a_rs, b + 2 * n2, b_rs, c + 2 * n2, c_rs);
+  }
+  if (m % 2) {
+    Overwrite(1, n, k, a + 2 * m2 * a_rs, a_rs, b, b_rs, c + 2 * m2 * c_rs,
+              c_rs);
+  }
+}
+
+template void Gemm<float>(int, int, int, const float*, Stride, Stride,
+                          const float*, Stride, Stride, float*, Stride);
+template void Gemm<double>(int, int, int, const double*, Stride, Stride,
+                           const double*, Stride, Stride, double*, Stride);
+template void Gemm<long double>(int, int, int, const long double*, Stride,
+                                Stride, const long double*, Stride, Stride,
+                                long double*, Stride);
+
+template void StrassenGemm<float>(int, int, int, const float*, Stride,
+                                  const float*, Stride, float*, Stride, int);
+template void StrassenGemm<double>(int, int, int, const double*, Stride,
+                                   const double*, Stride, double*, Stride,
+                                   int);
+template void StrassenGemm<long double>(int, int, int, const long double*,
+                                        Stride, const long double*, Stride,
+                                        long double*, Stride, int);
+
+}  // namespace s21
@@ -0,0 +1,37 @@
+#ifndef MATRIX_SRC_S21_MATRIX_GEMM_H
+#define MATRIX_SRC_S21_MATRIX_GEMM_H
+
+#include <cstddef>
+
+namespace s21 {
+
+// Шаг в элементах. Знаковый 64-битный тип, чтобы смещение i * a_rs
+// не переполнялось у матриц больше 2^31 элементов
+using Stride = std::ptrdiff_t;
+
+// C += A * B, где A — m x k, B — k x n, C — m x n.
+// Элемент A(i, p) берётся по адресу a[i * a_rs + p * a_cs], аналогично для B,
+// строки C идут с шагом c_rs. Ядро блочное (по схеме BLIS/GotoBLAS):
+// панели A и B упаковываются в буферы под L2/L3, а внутренний цикл —
+// регистровое микроядро kMr x kNr. Крупные произведения делятся на блоки
+// C и выполняются общим пулом S21ThreadPool::Global().
+// Определено для float, double и long double.
+template <typename T>
+void Gemm(int m, int n, int k, const T* a, Stride a_rs, Stride a_cs, const T* b,
+          Stride b_rs, Stride b_cs, T* c, Stride c_rs);
+
+// C = A * B по схеме Штрассена–Винограда: 7 умножений и 15 сложений
+// половинных блоков на уровень вместо 8 умножений. Рекурсия идёт, пока
+// все размеры не меньше threshold, дальше работает Gemm. Нечётная строка,
+// столбец или внутренний размер на каждом уровне отщепляются и
+// досчитываются через Gemm. Строки A, B и C идут с шагами a_rs, b_rs, c_rs.
+template <typename T>
+void StrassenGemm(int m, int n, int k, const T* a, Stride a_rs, const T* b,
+                  Stride b_rs, T* c, Stride c_rs, int threshold);
+
+// Число уровней рекурсии StrassenGemm для этих размеров
+int StrassenDepth(int m, int n, int k, int threshold);
+
+}  // namespace s21
+
+#endif  // MATRIX_SRC_S21_MATRIX_GEMM_H
@@ -0,0 +1,214 @@
+#include "s21_matrix_io.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+using s21::io::DType;
+
+constexpr char kMagic[8] = {'S', '2', '1', 'M', 'A', 'T', 'R', 'X'};
+constexpr std::uint32_t kVersion = 1;
+constexpr std::size_t kHeaderSize = 64;
+
+struct Header {
+  char magic[8];
+  std::uint32_t version;
+  std::uint32_t dtype;
+  std::uint32_t element_size;
+  std::uint32_t alignment;
+  std::uint64_t rows;
+  std::uint64_t cols;
+  std::uint64_t data_offset;
+  char reserved[16];
+};
+
+static_assert(sizeof(Header) == kHeaderSize, "Header must take 64 bytes");
+
+struct FileCloser {
+  void operator()(std::FILE* file) const { std::fclose(file); }
+};
+
+using File = std::unique_ptr<std::FILE, FileCloser>;
+
+File OpenFile(const std::string& path, const char* mode) {
+  File file(std::fopen(path.c_str(), mode));
+  if (!file) throw std::runtime_error("Cannot open file " + path);
+  return file;
+}
+
+// Проверка заголовка; размер данных в байтах
+std::size_t CheckHeader(const Header& header, DType dtype,
+                        std::size_t element_size) {
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      header.version != kVersion || header.data_offset < kHeaderSize ||
+      header.data_offset % S21MatrixAllocator::kAlignment != 0 ||
+      header.rows > INT_MAX || header.cols > INT_MAX ||
+      (header.rows == 0) != (header.cols == 0) ||
+      (header.rows > 0 &&
+       header.cols > SIZE_MAX / element_size / header.rows)) {
+    throw std::invalid_argument("Incorrect matrix file");
+  }
+  if (header.dtype != static_cast<std::uint32_t>(dtype) ||
+      header.element_size != element_size) {
+    throw std::invalid_argument("Element types of matrices are different");
+  }
+  return header.rows * header.cols * element_size;
+}
+
+Header MakeHeader(DType dtype, std::size_t element_size, int rows,
+                  int cols) {
+  Header header = {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.dtype = static_cast<std::uint32_t>(dtype);
+  header.element_size = static_cast<std::uint32_t>(element_size);
+  header.alignment = S21MatrixAllocator::kAlignment;
+  header.rows = rows;
+  header.cols = cols;
+  header.data_offset = kHeaderSize;
+  return header;
+}
+
+}  // namespace
+
+namespace s21 {
+namespace io {
+
+FileInfo ReadInfo(const std::string& path, DType dtype,
+                  std::size_t element_size) {
+  File file = OpenFile(path, "rb");
+  Header header;
+  if (std::fread(&header, sizeof(header), 1, file.get()) != 1) {
+    throw std::invalid_argument("Incorrect matrix file");
+  }
+  CheckHeader(header, dtype, element_size);
+  return {static_cast<int>(header.rows), static_cast<int>(header.cols),
+          static_cast<std::size_t>(header.data_offset)};
+}
+
+FileInfo Create(const std::string& path, DType dtype,
+                std::size_t element_size, int rows, int cols) {
+  const Header header = MakeHeader(dtype, element_size, rows, cols);
+  File file = OpenFile(path, "wb");
+  const std::size_t bytes =
+      static_cast<std::size_t>(rows) * cols * element_size;
+  // Размер файла задаётся без записи нулей
+  if (std::fwrite(&header, sizeof(header), 1, file.get()) != 1 ||
+      std::fflush(file.get()) != 0 ||
+      ::ftruncate(::fileno(file.get()),
+                  static_cast<off_t>(kHeaderSize + bytes)) != 0) {
+    throw std::runtime_error("Cannot write file " + path);
+  }
+  return {rows, cols, kHeaderSize};
+}
+
+/////////////          Чтение и запись        /////////////////
+
+void Save(const std::string& path, DType dtype, std::size_t element_size,
+          const void* data, int rows, int cols, int stride) {
+  const Header header = MakeHeader(dtype, element_size, rows, cols);
+  File file = OpenFile(path, "wb");
+  bool ok = std::fwrite(&header, sizeof(header), 1, file.get()) == 1;
+  const char* bytes = static_cast<const char*>(data);
+  const std::size_t row_bytes = static_cast<std::size_t>(cols) * element_size;
+  const std::size_t stride_bytes =
+      static_cast<std::size_t>(stride) * element_size;
+  for (int i = 0; ok && i < rows; i++) {
+    ok = std::fwrite(bytes + static_cast<std::size_t>(i) * stride_bytes, 1,
+                     row_bytes, file.get()) == row_bytes;
+  }
+  if (!ok || std::fflush(file.get()) != 0) {
+    throw std::runtime_error("Cannot write file " + path);
+  }
+}
+
+void Load(const std::string& path, DType dtype, std::size_t element_size,
+          const std::function<void*(int, int)>& allocate) {
+  File file = OpenFile(path, "rb");
+  Header header;
+  if (std::fread(&header, sizeof(header), 1, file.get()) != 1) {
+    throw std::invalid_argument("Incorrect matrix file");
+  }
+  const std::size_t bytes = CheckHeader(header, dtype, element_size);
+  void* data = allocate(static_cast<int>(header.rows),
+                        static_cast<int>(header.cols));
+  if (bytes > 0 &&
+      (std::fseek(file.get(), static_cast<long>(header.data_offset),
+                  SEEK_SET) != 0 ||
+       std::fread(data, 1, bytes, file.get()) != bytes)) {
+    throw std::invalid_argument("Incorrect matrix file");
+  }
+}
+
+/////////////          Отображение в память        /////////////////
+
+MappedFile* MappedFile::Open(const std::string& path, DType dtype,
+                             std::size_t element_size) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Cannot open file " + path);
+  struct stat info;
+  Header header;
+  const bool read_ok =
+      ::fstat(fd, &info) == 0 &&
+      ::pread(fd, &header, sizeof(header), 0) ==
+          static_cast<ssize_t>(sizeof(header));
+  if (!read_ok) {
+    ::close(fd);
+    throw std::invalid_argument("Incorrect matrix file");
+  }
+  std::size_t bytes = 0;
+  try {
+    bytes = CheckHeader(header, dtype, element_size);
+  } catch (...) {
+    ::close(fd);
+    throw;
+  }
+  const std::size_t length = header.data_offset + bytes;
+  if (static_cast<std::size_t>(info.st_size) < length) {
+    ::close(fd);
+    throw std::invalid_argument("Incorrect matrix file");
+  }
+  if (bytes == 0) {
+    ::close(fd);
+    return nullptr;
+  }
+  // Отображение остаётся действительным после закрытия дескриптора
+  void* base = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                      fd, 0);
+  ::close(fd);
+  if (base == MAP_FAILED) throw std::runtime_error("Cannot map file " + path);
+  return new MappedFile(base, length, header.data_offset,
+                        static_cast<int>(header.rows),
+                        static_cast<int>(header.cols));
+}
+
+MappedFile::MappedFile(void* base, std::size_t length, std::size_t offset,
+                       int rows, int cols)
+    : base_(base), length_(length), offset_(offset), rows_(rows),
+      cols_(cols) {}
+
+MappedFile::~MappedFile() { ::munmap(base_, length_); }
+
+int MappedFile::GetRows() const { return rows_; }
+
+int MappedFile::GetCols() const { return cols_; }
+
+void* MappedFile::Data() const { return static_cast<char*>(base_) + offset_; }
+
+void* MappedFile::Allocate(std::size_t) { throw std::bad_alloc(); }
+
+void MappedFile::Deallocate(void*, std::size_t) { delete this; }
+
+}  // namespace io
+}  // namespace s21
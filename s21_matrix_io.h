@@ -0,0 +1,102 @@
+#ifndef MATRIX_SRC_S21_MATRIX_IO_H
+#define MATRIX_SRC_S21_MATRIX_IO_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "s21_matrix_allocator.h"
+
+// Двоичный формат файла матрицы (порядок байт машины):
+//   0  char[8]  "S21MATRX"
+//   8  uint32   версия формата (1)
+//   12 uint32   тип элементов DType
+//   16 uint32   размер элемента в байтах
+//   20 uint32   выравнивание данных (S21MatrixAllocator::kAlignment)
+//   24 uint64   число строк
+//   32 uint64   число столбцов
+//   40 uint64   смещение данных от начала файла
+//   48          нули до 64 байт
+// Далее rows x cols элементов построчно без промежутков. Данные
+// начинаются с выровненного смещения, поэтому отображённый в память
+// файл пригоден для векторных ядер без копирования.
+namespace s21 {
+namespace io {
+
+enum class DType : std::uint32_t { kFloat = 1, kDouble = 2, kLongDouble = 3 };
+
+template <typename T>
+struct DTypeOf;
+
+template <>
+struct DTypeOf<float> {
+  static constexpr DType kValue = DType::kFloat;
+};
+
+template <>
+struct DTypeOf<double> {
+  static constexpr DType kValue = DType::kDouble;
+};
+
+template <>
+struct DTypeOf<long double> {
+  static constexpr DType kValue = DType::kLongDouble;
+};
+
+// Размеры матрицы в файле и смещение её данных
+struct FileInfo {
+  int rows, cols;
+  std::size_t data_offset;
+};
+
+// Заголовок файла path с проверкой типа элементов
+FileInfo ReadInfo(const std::string& path, DType dtype,
+                  std::size_t element_size);
+// Файл path с заголовком и местом под rows x cols элементов (нули),
+// которые затем дописываются по частям
+FileInfo Create(const std::string& path, DType dtype,
+                std::size_t element_size, int rows, int cols);
+
+// Строки data с шагом stride элементов записываются в файл path
+void Save(const std::string& path, DType dtype, std::size_t element_size,
+          const void* data, int rows, int cols, int stride);
+
+// Читает файл path: allocate(rows, cols) возвращает буфер под
+// rows * cols элементов подряд, в который читаются данные
+void Load(const std::string& path, DType dtype, std::size_t element_size,
+          const std::function<void*(int, int)>& allocate);
+
+// Файл, отображённый в память с MAP_PRIVATE: страницы, которые никто
+// не менял, общие для всех процессов через кэш страниц, запись в них
+// копирует страницу только для этого процесса и не доходит до файла.
+// Служит аллокатором блока матрицы: Deallocate снимает отображение
+// и удаляет объект, новых блоков он не выдаёт.
+class MappedFile : public S21MatrixAllocator {
+ public:
+  // nullptr для матрицы без элементов
+  static MappedFile* Open(const std::string& path, DType dtype,
+                          std::size_t element_size);
+
+  int GetRows() const;
+  int GetCols() const;
+  void* Data() const;
+
+  void* Allocate(std::size_t bytes) override;
+  void Deallocate(void* block, std::size_t bytes) override;
+
+ private:
+  MappedFile(void* base, std::size_t length, std::size_t offset, int rows,
+             int cols);
+  ~MappedFile() override;
+
+  void* base_;
+  std::size_t length_;
+  std::size_t offset_;
+  int rows_, cols_;
+};
+
+}  // namespace io
+}  // namespace s21
+
+#endif  // MATRIX_SRC_S21_MATRIX_IO_H
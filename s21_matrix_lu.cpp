@@ -0,0 +1,251 @@
+#include <algorithm>
+#include <utility>
+
+#include "s21_matrix_oop.h"
+#include "s21_matrix_small.h"
+#include "s21_thread_pool.h"
+
+/////////////          Разложение        /////////////////
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrix<T>& matrix)
+    : lu_(matrix), sign_(0), singular_(true) {
+  Factorize();
+}
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(S21BasicMatrix<T>&& matrix)
+    : lu_(std::move(matrix)), sign_(0), singular_(true) {
+  Factorize();
+}
+
+template <typename T>
+S21BasicLU<T>::S21BasicLU(const S21BasicMatrixView<T>& matrix)
+    : lu_(matrix), sign_(0), singular_(true) {
+  Factorize();
+}
+
+template <typename T>
+void S21BasicLU<T>::Factorize() {
+  if (lu_.rows_ != lu_.cols_ || lu_.rows_ <= 0) {
+    throw std::invalid_argument("Matrix isn't square");
+  }
+  const int n = lu_.rows_;
+  std::vector<T> row_scale(n), col_scale(n);
+  auto e = [this](int i, int j) { return lu_.At(i, j); };
+  s21::small_matrix::Scales<T>(e, n, row_scale.data(), col_scale.data());
+  pivots_.assign(n, 0);
+  sign_ = s21::small_matrix::LuDecompose(lu_.matrix_, n, lu_.cols_,
+                                        pivots_.data());
+  singular_ = sign_ == 0 || s21::small_matrix::HasNegligiblePivot(
+                                lu_.matrix_, n, lu_.cols_, pivots_.data(),
+                                row_scale.data(), col_scale.data());
+}
+
+template <typename T>
+int S21BasicLU<T>::GetSize() const {
+  return lu_.rows_;
+}
+
+template <typename T>
+bool S21BasicLU<T>::IsSingular() const {
+  return singular_;
+}
+
+template <typename T>
+T S21BasicLU<T>::Determinant() const {
+  T result = sign_;
+  for (int i = 0; result && i < lu_.rows_; i++) {
+    result *= lu_.At(i, i);
+  }
+  return result;
+}
+
+/////////////          Решение систем        /////////////////
+
+template <typename T>
+std::vector<T> S21BasicLU<T>::Solve(const std::vector<T>& b) const {
+  const int n = lu_.rows_;
+  if (static_cast<int>(b.size()) != n) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  CheckSingular();
+  const T* a = lu_.matrix_;
+  const std::size_t rs = lu_.cols_;
+
+  std::vector<T> x(b);
+  for (int k = 0; k < n; k++) {
+    if (pivots_[k] != k) std::swap(x[k], x[pivots_[k]]);
+  }
+  for (int i = 1; i < n; i++) {
+    T sum = x[i];
+    for (int k = 0; k < i; k++) {
+      sum -= a[i * rs + k] * x[k];
+    }
+    x[i] = sum;
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    T sum = x[i];
+    for (int k = i + 1; k < n; k++) {
+      sum -= a[i * rs + k] * x[k];
+    }
+    x[i] = sum / a[i * rs + i];
+  }
+  return x;
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Solve(const S21BasicMatrix<T>& b) const {
+  const int n = lu_.rows_;
+  if (b.rows_ != n) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  CheckSingular();
+  S21BasicMatrix<T> x(b);
+  SolveInPlace(x.matrix_, x.cols_, x.cols_);
+  return x;
+}
+
+// Подстановки идут строками X, чтобы внутренний цикл по столбцам правой
+// части был непрерывным
+template <typename T>
+void S21BasicLU<T>::SolveInPlace(T* data, int cols, std::size_t xs) const {
+  const int n = lu_.rows_;
+  const T* a = lu_.matrix_;
+  const std::size_t rs = lu_.cols_;
+  for (int k = 0; k < n; k++) {
+    if (pivots_[k] != k) {
+      std::swap_ranges(data + k * xs, data + k * xs + cols,
+                       data + pivots_[k] * xs);
+    }
+  }
+  for (int i = 1; i < n; i++) {
+    T* row_i = data + i * xs;
+    for (int k = 0; k < i; k++) {
+      const T factor = a[i * rs + k];
+      if (factor == 0.0) continue;
+      const T* row_k = data + k * xs;
+      for (int j = 0; j < cols; j++) {
+        row_i[j] -= factor * row_k[j];
+      }
+    }
+  }
+  for (int i = n - 1; i >= 0; i--) {
+    T* row_i = data + i * xs;
+    for (int k = i + 1; k < n; k++) {
+      const T factor = a[i * rs + k];
+      if (factor == 0.0) continue;
+      const T* row_k = data + k * xs;
+      for (int j = 0; j < cols; j++) {
+        row_i[j] -= factor * row_k[j];
+      }
+    }
+    const T diagonal = a[i * rs + i];
+    for (int j = 0; j < cols; j++) {
+      row_i[j] /= diagonal;
+    }
+  }
+}
+
+/////////////          Обратная матрица        /////////////////
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() const& {
+  S21BasicLU copy(*this);
+  return std::move(copy).Inverse();
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Inverse() && {
+  CheckSingular();
+  InvertInPlace();
+  sign_ = 0;
+  singular_ = true;
+  return std::move(lu_);
+}
+
+/////////////          Алгебраические дополнения        /////////////////
+
+// A(i, j) = det * inv(j, i): блок столбцов единичной матрицы решается
+// в буфере потока и записывается строками результата, так что задачи
+// пишут в непересекающиеся строки
+template <typename T>
+S21BasicMatrix<T> S21BasicLU<T>::Cofactors() const {
+  CheckSingular();
+  const int n = lu_.rows_;
+  const T det = Determinant();
+  S21BasicMatrix<T> result(n, n);
+  const int block = 32;
+  const int tasks = (n + block - 1) / block;
+  S21ThreadPool::Global().ParallelFor(tasks, [&](int task) {
+    thread_local std::vector<T> scratch;
+    const int first = task * block;
+    const int width = std::min(block, n - first);
+    scratch.assign(static_cast<std::size_t>(n) * width, T(0));
+    for (int j = 0; j < width; j++) scratch[(first + j) * width + j] = 1;
+    SolveInPlace(scratch.data(), width, width);
+    for (int j = 0; j < width; j++) {
+      T* row = result.matrix_ + result.Offset(first + j, 0);
+      for (int i = 0; i < n; i++) row[i] = det * scratch[i * width + j];
+    }
+  });
+  return result;
+}
+
+template <typename T>
+void S21BasicLU<T>::CheckSingular() const {
+  if (IsSingular()) {
+    throw std::out_of_range("Determenant equal 0");
+  }
+}
+
+// Обращение по схеме getri: inv(A) = inv(U) * inv(L) * P
+// вычисляется на месте упакованных множителей
+template <typename T>
+void S21BasicLU<T>::InvertInPlace() {
+  const int n = lu_.rows_;
+  T* a = lu_.matrix_;
+  const std::size_t rs = lu_.cols_;
+
+  // inv(U) на месте U: столбцы слева направо, строки сверху вниз
+  for (int j = 0; j < n; j++) {
+    a[j * rs + j] = T(1) / a[j * rs + j];
+    for (int i = 0; i < j; i++) {
+      T sum = 0.0;
+      for (int k = i; k < j; k++) {
+        sum += a[i * rs + k] * a[k * rs + j];
+      }
+      a[i * rs + j] = -sum * a[j * rs + j];
+    }
+  }
+
+  // Решение X * L = inv(U) справа налево по столбцам
+  std::vector<T> work(n);
+  for (int j = n - 2; j >= 0; j--) {
+    for (int i = j + 1; i < n; i++) {
+      work[i] = a[i * rs + j];
+      a[i * rs + j] = 0.0;
+    }
+    for (int r = 0; r < n; r++) {
+      T* row = a + r * rs;
+      T sum = 0.0;
+      for (int i = j + 1; i < n; i++) {
+        sum += row[i] * work[i];
+      }
+      row[j] -= sum;
+    }
+  }
+
+  // Обратные перестановки столбцов
+  for (int j = n - 2; j >= 0; j--) {
+    if (pivots_[j] != j) {
+      for (int r = 0; r < n; r++) {
+        std::swap(a[r * rs + j], a[r * rs + pivots_[j]]);
+      }
+    }
+  }
+}
+
+template class S21BasicLU<float>;
+template class S21BasicLU<double>;
+template class S21BasicLU<long double>;
@@ -1,406 +1,671 @@
 #include "s21_matrix_oop.h"
 
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <limits>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_io.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_small.h"
+#include "s21_matrix_stats.h"
+#include "s21_thread_pool.h"
+
 /////////////          Конструкторы и деструктор        /////////////////
 
-S21Matrix::S21Matrix() {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix() {
   rows_ = 0;
   cols_ = 0;
   matrix_ = nullptr;
+  allocator_ = nullptr;
+  block_size_ = 0;
 }
 
-S21Matrix::S21Matrix(int rows, int cols) : rows_(rows), cols_(cols) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols) {
   if (rows_ <= 0 || cols_ <= 0) {
     rows_ = 0;
     cols_ = 0;
-    matrix_ = nullptr;
-  } else {
-    AllocateMemory();
   }
+  AllocateMemory();
 }
 
-S21Matrix::S21Matrix(const S21Matrix& other) {
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(const S21BasicMatrix& other) {
   rows_ = other.rows_;
   cols_ = other.cols_;
-  AllocateMemory();
+  AllocateMemory(false);
   CopyMatrix(other.matrix_);
 }
 
-S21Matrix::S21Matrix(S21Matrix&& other) noexcept {
-  std::swap(rows_, other.rows_);
-  std::swap(cols_, other.cols_);
-  std::swap(matrix_, other.matrix_);
-  other.rows_ = 0;
-  other.cols_ = 0;
-  other.matrix_ = nullptr;
+template <typename T>
+S21BasicMatrix<T>::S21BasicMatrix(S21BasicMatrix&& other) noexcept {
+  TakeStorage(other);
 }
 
-S21Matrix::~S21Matrix() {
+template <typename T>
+S21BasicMatrix<T>::~S21BasicMatrix() {
   if (this->matrix_) {
     FreeingMemory();
     rows_ = 0;
     cols_ = 0;
-    matrix_ = nullptr;
   }
 }
 
 /////////////    Базовые функции для работы с матрицами   /////////////////
 
-bool S21Matrix::EqMatrix(const S21Matrix& other) {
+template <typename T>
+bool S21BasicMatrix<T>::EqMatrix(const S21BasicMatrix& other) const {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     return false;
   }
 
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      if (fabs(matrix_[i][j] - other.matrix_[i][j]) > 1E-07) {
-        return false;
-      }
-    }
-  }
-  return true;
+  return s21::simd::EqualWithin(matrix_, other.matrix_, Size(), kEpsilon);
 }
 
-void S21Matrix::SumMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Sizes of matrices are different");
   }
+  S21_MATRIX_OP(kSumMatrix, Size());
 
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] += other.matrix_[i][j];
-    }
-  }
+  s21::simd::Add(matrix_, other.matrix_, Size());
 }
 
-void S21Matrix::SubMatrix(const S21Matrix& other) {
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrix& other) {
   if (rows_ != other.rows_ || cols_ != other.cols_) {
     throw std::invalid_argument("Sizes of matrices are different");
   }
+  S21_MATRIX_OP(kSubMatrix, Size());
 
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] -= other.matrix_[i][j];
-    }
+  s21::simd::Sub(matrix_, other.matrix_, Size());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulNumber(const T num) {
+  S21_MATRIX_OP(kMulNumber, Size());
+  s21::simd::Scale(matrix_, num, Size());
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrix& other) {
+  *this = Product(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SumMatrix(const S21BasicMatrixView<T>& other) {
+  View().SumMatrix(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::SubMatrix(const S21BasicMatrixView<T>& other) {
+  View().SubMatrix(other);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::MulMatrix(const S21BasicMatrixView<T>& other) {
+  if (cols_ != other.GetRows()) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
   }
+  S21_MATRIX_OP(kMulMatrix, 2.0 * rows_ * other.GetCols() * cols_);
+  S21BasicMatrix result(rows_, other.GetCols());
+  s21::Gemm(rows_, other.GetCols(), cols_, matrix_, cols_, 1, other.Data(),
+            other.RowStride(), other.ColStride(), result.matrix_,
+            result.cols_);
+  *this = std::move(result);
 }
 
-void S21Matrix::MulNumber(const double num) {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] *= num;
-    }
+template <typename T>
+void S21BasicMatrix<T>::MulMatrixStrassen(const S21BasicMatrix& other,
+                                          int threshold) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
   }
+  // Учитывается как классическое умножение того же размера
+  S21_MATRIX_OP(kMulMatrix, 2.0 * rows_ * other.cols_ * cols_);
+  S21BasicMatrix result(rows_, other.cols_);
+  s21::StrassenGemm(rows_, other.cols_, cols_, matrix_, cols_,
+                    other.matrix_, other.cols_, result.matrix_,
+                    result.cols_, threshold);
+  *this = std::move(result);
 }
 
-void S21Matrix::MulMatrix(const S21Matrix& other) {
+// Классическое умножение: |C - fl(C)| <= k * u * |A| * |B| поэлементно,
+// отсюда max|C - fl(C)| <= k^2 * u * max|A| * max|B|
+template <typename T>
+T S21BasicMatrix<T>::MulErrorBound(const S21BasicMatrix& other) {
   if (cols_ != other.rows_) {
     throw std::invalid_argument(
         "Count cols first matrix not equal count rows second matrix");
   }
-  S21Matrix temp(rows_, other.cols_);
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < other.cols_; j++) {
-      double sum = 0;
-      for (int k = 0; k < cols_; k++) {
-        sum += matrix_[i][k] * other.matrix_[k][j];
-      }
-      temp.matrix_[i][j] = sum;
-    }
+  const T u = std::numeric_limits<T>::epsilon() / 2;
+  return T(cols_) * cols_ * u * MaxAbs() * other.MaxAbs();
+}
+
+// Штрассен–Виноград с d уровнями рекурсии до блоков порядка n0 = n / 2^d:
+// max|C - fl(C)| <= (18^d * (n0^2 + 6 * n0) - 6 * n) * u * max|A| * max|B|
+// (Higham, «Accuracy and Stability of Numerical Algorithms», 2-е изд.,
+// теорема 23.3 для варианта Винограда); n — наибольший из размеров
+template <typename T>
+T S21BasicMatrix<T>::StrassenErrorBound(const S21BasicMatrix& other,
+                                        int threshold) {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
   }
-  this->FreeingMemory();
-  cols_ = other.cols_;
-  matrix_ = temp.matrix_;
-  temp.matrix_ = nullptr;
+  const int depth = s21::StrassenDepth(rows_, other.cols_, cols_, threshold);
+  if (depth == 0) return MulErrorBound(other);
+  const T n = std::max(std::max(rows_, other.cols_), cols_);
+  const T n0 = n / std::pow(T(2), depth);
+  const T u = std::numeric_limits<T>::epsilon() / 2;
+  return (std::pow(T(18), depth) * (n0 * n0 + 6 * n0) - 6 * n) * u *
+         MaxAbs() * other.MaxAbs();
 }
 
-S21Matrix S21Matrix::Transpose() {
-  S21Matrix result(cols_, rows_);
-  for (int j = 0; j < cols_; j++) {
-    for (int i = 0; i < rows_; i++) {
-      result.matrix_[j][i] = matrix_[i][j];
-    }
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transpose() {
+  S21_MATRIX_OP(kTranspose, 0);
+  return Transposed();
+}
+
+template <typename T>
+void S21BasicMatrix<T>::TransposeInPlace() {
+  // Учитывается один раз при любой форме матрицы
+  S21_MATRIX_OP(kTranspose, 0);
+  if (rows_ == cols_) {
+    s21::simd::TransposeInPlace(matrix_, rows_, cols_);
+  } else {
+    *this = Transposed();
   }
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Transposed() const {
+  S21BasicMatrix result;
+  result.rows_ = cols_;
+  result.cols_ = rows_;
+  result.AllocateMemory(false);
+  s21::simd::Transpose(matrix_, rows_, cols_, cols_, result.matrix_,
+                       result.cols_);
   return result;
 }
 
-S21Matrix S21Matrix::CalcComplements() {
-  S21Matrix result(rows_, cols_);
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::CalcComplements() {
   if (rows_ != cols_ || rows_ <= 0) {
     throw std::invalid_argument("Matrix isn't square");
   }
+  // Оценка для невырожденной матрицы: LU-разложение и решение n систем
+  S21_MATRIX_OP(kCalcComplements, 8.0 / 3 * rows_ * rows_ * rows_);
+  // Невырожденная матрица: одно LU-разложение и det * inv^T
+  if (rows_ > 2) {
+    S21BasicLU<T> lu(*this);
+    if (!lu.IsSingular()) return lu.Cofactors();
+  }
+
+  S21BasicMatrix result(rows_, cols_);
+  T* r = result.matrix_;
+  const std::size_t rs = result.cols_;
   if (rows_ == 1) {
-    result.matrix_[0][0] = 1;
-  } else if (rows_ == 2) {
-    result.matrix_[0][0] = matrix_[1][1];
-    result.matrix_[0][1] = -matrix_[1][0];
-    result.matrix_[1][0] = -matrix_[0][1];
-    result.matrix_[1][1] = matrix_[0][0];
-  } else {
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < cols_; j++) {
-        result.matrix_[i][j] = Minor(i, j) * pow(-1, (i + j));
-      }
+    r[0] = 1;
+    return result;
+  }
+  if (rows_ == 2) {
+    r[0] = matrix_[cols_ + 1];
+    r[1] = -matrix_[cols_];
+    r[rs] = -matrix_[1];
+    r[rs + 1] = matrix_[0];
+    return result;
+  }
+
+  // Вырожденная: n^2 миноров, строки результата делятся между потоками,
+  // каждый поток считает миноры в своём буфере без выделений памяти
+  const int n = rows_;
+  S21ThreadPool::Global().ParallelFor(n, [&](int i) {
+    thread_local std::vector<T> scratch;
+    scratch.resize(static_cast<std::size_t>(n - 1) * (n - 1));
+    for (int j = 0; j < n; j++) {
+      const T minor = Minor(i, j, scratch.data());
+      r[i * rs + j] = (i + j) % 2 ? -minor : minor;
     }
-  }
+  });
   return result;
 }
 
-double S21Matrix::Determinant() {
-  double result = 0.0;
+template <typename T>
+T S21BasicMatrix<T>::Determinant() {
   if (rows_ != cols_ || rows_ <= 0) {
     throw std::invalid_argument("Matrix isn't square");
   }
-  S21Matrix temp = CalcComplements();
-
-  for (int i = 0; i < rows_; i++) {
-    result += matrix_[0][i] * temp.matrix_[0][i];
+  S21_MATRIX_OP(kDeterminant, 2.0 / 3 * rows_ * rows_ * rows_);
+  // До порядка 4 — явная формула, как у S21FixedMatrix и
+  // S21BasicMatrixBatch: для целых элементов она даёт точный ноль
+  if (rows_ <= 4) {
+    auto e = [this](int i, int j) { return At(i, j); };
+    return s21::small_matrix::ClosedDeterminant<T>(e, rows_);
   }
-  return result;
+  return S21BasicLU<T>(*this).Determinant();
 }
 
-S21Matrix S21Matrix::InverseMatrix() {
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::InverseMatrix() {
   if (rows_ != cols_ || rows_ <= 0) {
     throw std::invalid_argument("Matrix isn't square");
   }
-  double det = Determinant();
-  if (fabs(det) < 1E-07) {
-    throw std::out_of_range("Determenant equal 0");
-  }
+  S21_MATRIX_OP(kInverseMatrix, 2.0 * rows_ * rows_ * rows_);
+  return S21BasicLU<T>(*this).Inverse();
+}
 
-  S21Matrix result = CalcComplements();
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      result.matrix_[i][j] /= det;
-    }
-  }
-  result = result.Transpose();
-  return result;
+template <typename T>
+S21BasicLU<T> S21BasicMatrix<T>::LU() {
+  return S21BasicLU<T>(*this);
 }
 
 /////////////     Перегрузка операторов    /////////////////
 
-S21Matrix& S21Matrix::operator=(const S21Matrix& x) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21BasicMatrix& x) {
   if (this == &x) return *this;
-  if (matrix_) {
-    FreeingMemory();
+  if (block_size_ != x.Size()) {
+    if (matrix_) {
+      FreeingMemory();
+    }
+    rows_ = x.rows_;
+    cols_ = x.cols_;
+    AllocateMemory(false);
+  } else {
+    // Блок того же размера переиспользуется без обращения к аллокатору
+    rows_ = x.rows_;
+    cols_ = x.cols_;
   }
-  rows_ = x.rows_;
-  cols_ = x.cols_;
-  AllocateMemory();
   CopyMatrix(x.matrix_);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator=(S21Matrix&& x) noexcept {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(S21BasicMatrix&& x) noexcept {
   if (this == &x) return *this;
   if (matrix_) {
     FreeingMemory();
   }
-  std::swap(rows_, x.rows_);
-  std::swap(cols_, x.cols_);
-  std::swap(matrix_, x.matrix_);
-  x.matrix_ = nullptr;
+  TakeStorage(x);
   return *this;
 }
 
-bool S21Matrix::operator==(const S21Matrix& x) { return EqMatrix(x); }
-
-S21Matrix S21Matrix::operator+(const S21Matrix& x) {
-  S21Matrix result = *this;
-  result.SumMatrix(x);
-  return result;
-}
-
-S21Matrix S21Matrix::operator-(const S21Matrix& x) {
-  S21Matrix result = *this;
-  result.SubMatrix(x);
-  return result;
-}
-
-S21Matrix S21Matrix::operator*(const S21Matrix& x) {
-  S21Matrix result = *this;
-  result.MulMatrix(x);
-  return result;
-}
-
-S21Matrix S21Matrix::operator*(double x) {
-  S21Matrix result = *this;
-  result.MulNumber(x);
-  return result;
-}
-
-S21Matrix operator*(const double x, const S21Matrix& y) {
-  S21Matrix result = y;
-  result.MulNumber(x);
-  return result;
-}
-
-S21Matrix& S21Matrix::operator+=(const S21Matrix& x) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21BasicMatrix& x) {
   this->SumMatrix(x);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator-=(const S21Matrix& x) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21BasicMatrix& x) {
   this->SubMatrix(x);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const S21Matrix& x) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const S21BasicMatrix& x) {
   this->MulMatrix(x);
   return *this;
 }
 
-S21Matrix& S21Matrix::operator*=(const double x) {
+template <typename T>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator*=(const T x) {
   this->MulNumber(x);
   return *this;
 }
 
-double& S21Matrix::operator()(int i, int j) {
+template <typename T>
+T& S21BasicMatrix<T>::operator()(int i, int j) {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  return matrix_[Offset(i, j)];
+}
+
+template <typename T>
+T S21BasicMatrix<T>::operator()(int i, int j) const {
   if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
     throw std::out_of_range("Out of range. Incorrect input");
   }
-  return matrix_[i][j];
+  return matrix_[Offset(i, j)];
+}
+
+template <typename T>
+S21Span<T> S21BasicMatrix<T>::Row(int i) {
+  if (i < 0 || i >= rows_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  return S21Span<T>(matrix_ + Offset(i, 0), cols_);
+}
+
+template <typename T>
+S21Span<const T> S21BasicMatrix<T>::Row(int i) const {
+  if (i < 0 || i >= rows_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  return S21Span<const T>(matrix_ + Offset(i, 0), cols_);
+}
+
+template <typename T>
+T* S21BasicMatrix<T>::Data() { return matrix_; }
+
+template <typename T>
+const T* S21BasicMatrix<T>::Data() const { return matrix_; }
+
+/////////////     Окна    /////////////////
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::View() {
+  return S21BasicMatrixView<T>(matrix_, rows_, cols_, cols_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::RowView(int i) {
+  return View().Row(i);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::ColView(int j) {
+  return View().Col(j);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::BlockView(int row, int col, int rows,
+                                                   int cols) {
+  return View().Block(row, col, rows, cols);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrix<T>::TransposedView() {
+  return View().Transposed();
 }
 
 /////////////     Геттеры и сеттеры    /////////////////
 
-int S21Matrix::GetRows() { return rows_; }
+template <typename T>
+int S21BasicMatrix<T>::GetRows() const { return rows_; }
 
-int S21Matrix::GetCols() { return cols_; }
+template <typename T>
+int S21BasicMatrix<T>::GetCols() const { return cols_; }
 
-void S21Matrix::SetRows(int rows) {
+template <typename T>
+void S21BasicMatrix<T>::SetRows(int rows) {
   if (rows <= 0) {
     throw std::out_of_range("Incorrect value");
   } else if (rows_ != rows) {
-    double** newmatrix = new double*[rows];
-    for (int i = 0; i < rows; i++) {
-      newmatrix[i] = new double[cols_]{};
-    }
-    int size = (rows_ > rows ? rows : rows_);
-
-    for (int i = 0; i < size; i++) {
-      for (int j = 0; j < cols_; j++) {
-        newmatrix[i][j] = matrix_[i][j];
-      }
+    // Без столбцов размер только запоминается, блок выделит SetCols
+    const std::size_t size = static_cast<std::size_t>(rows) * cols_;
+    if (size > block_size_) Regrow(std::max(size, 2 * block_size_), cols_);
+    for (int i = rows_; i < rows; i++) {
+      std::fill(matrix_ + Offset(i, 0), matrix_ + Offset(i, cols_), T(0));
     }
-    FreeingMemory();
     rows_ = rows;
-    matrix_ = newmatrix;
   }
 }
 
-void S21Matrix::SetCols(int cols) {
+template <typename T>
+void S21BasicMatrix<T>::SetCols(int cols) {
   if (cols <= 0) {
     throw std::out_of_range("Incorrect value");
   } else if (cols_ != cols) {
-    double** newmatrix = new double*[rows_];
-    for (int i = 0; i < rows_; i++) {
-      newmatrix[i] = new double[cols]{};
-    }
-    int size = (cols_ > cols ? cols : cols_);
-
-    for (int i = 0; i < rows_; i++) {
-      for (int j = 0; j < size; j++) {
-        newmatrix[i][j] = matrix_[i][j];
-      }
+    const std::size_t size = static_cast<std::size_t>(rows_) * cols;
+    if (size > block_size_) {
+      Regrow(std::max(size, 2 * block_size_), cols);
+    } else {
+      Repack(cols);
     }
-    FreeingMemory();
-    cols_ = cols;
-    matrix_ = newmatrix;
   }
 }
 
-///////////       Вспомогательные функции   //////////////////
+template <typename T>
+int S21BasicMatrix<T>::GetRowCapacity() const {
+  if (cols_ == 0) return 0;
+  return static_cast<int>(
+      std::min<std::size_t>(block_size_ / cols_, INT_MAX));
+}
 
-void S21Matrix::AllocateMemory() {
-  matrix_ = new double*[rows_];
-  for (int i = 0; i < rows_; i++) {
-    matrix_[i] = new double[cols_]{};
+template <typename T>
+int S21BasicMatrix<T>::GetColCapacity() const {
+  if (rows_ == 0) return 0;
+  return static_cast<int>(
+      std::min<std::size_t>(block_size_ / rows_, INT_MAX));
+}
+
+template <typename T>
+void S21BasicMatrix<T>::Reserve(int rows, int cols) {
+  if (rows < 0 || cols < 0) {
+    throw std::out_of_range("Incorrect value");
   }
+  const std::size_t size = static_cast<std::size_t>(rows) * cols;
+  if (size > block_size_) Regrow(size, cols_);
 }
 
-void S21Matrix::FreeingMemory() {
-  for (int i = 0; i < rows_; i++) {
-    delete[] matrix_[i];
+template <typename T>
+void S21BasicMatrix<T>::ShrinkToFit() {
+  if (block_size_ != Size()) Regrow(Size(), cols_);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::AppendRow(const std::vector<T>& values) {
+  const int size = static_cast<int>(values.size());
+  if (rows_ == 0 && cols_ == 0 && size > 0) {
+    cols_ = size;
+  } else if (size != cols_ || size == 0) {
+    throw std::invalid_argument("Sizes of matrices are different");
   }
-  delete[] matrix_;
+  const std::size_t needed = Offset(rows_ + 1, 0);
+  if (needed > block_size_) Regrow(std::max(needed, 2 * block_size_), cols_);
+  std::copy(values.begin(), values.end(), matrix_ + Offset(rows_, 0));
+  rows_++;
 }
 
-void S21Matrix::CopyMatrix(double** sourse) {
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      matrix_[i][j] = sourse[i][j];
-    }
+/////////////     Файлы    /////////////////
+
+template <typename T>
+void S21BasicMatrix<T>::Save(const std::string& path) const {
+  s21::io::Save(path, s21::io::DTypeOf<T>::kValue, sizeof(T), matrix_, rows_,
+                cols_, cols_);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Load(const std::string& path) {
+  S21BasicMatrix result;
+  s21::io::Load(path, s21::io::DTypeOf<T>::kValue, sizeof(T),
+                [&result](int rows, int cols) -> void* {
+                  result.rows_ = rows;
+                  result.cols_ = cols;
+                  result.AllocateMemory(false);
+                  return result.matrix_;
+                });
+  return result;
+}
+
+// Отображение становится блоком матрицы и снимается при его освобождении
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Map(const std::string& path) {
+  S21BasicMatrix result;
+  s21::io::MappedFile* file = s21::io::MappedFile::Open(
+      path, s21::io::DTypeOf<T>::kValue, sizeof(T));
+  if (file) {
+    result.rows_ = file->GetRows();
+    result.cols_ = file->GetCols();
+    result.block_size_ = result.Size();
+    result.matrix_ = static_cast<T*>(file->Data());
+    result.allocator_ = file;
   }
+  return result;
 }
 
-double S21Matrix::Minor(int x, int y) {
-  double result = 0.0;
-  S21Matrix temp(rows_ - 1, cols_ - 1);
-  int a = 0, b = 0;
-  for (int i = 0; i < rows_; i++) {
-    for (int j = 0; j < cols_; j++) {
-      if (i != x && j != y) {
-        temp.matrix_[a][b++] = matrix_[i][j];
-        if (b == (rows_ - 1)) {
-          a++;
-          b = 0;
-        }
-      }
-    }
+template <typename T>
+void S21BasicMatrix<T>::SetThreadCount(int count) {
+  S21ThreadPool::Global().Resize(count);
+}
+
+template <typename T>
+int S21BasicMatrix<T>::GetThreadCount() {
+  return S21ThreadPool::Global().Size();
+}
+
+///////////       Вспомогательные функции   //////////////////
+
+template <typename T>
+void S21BasicMatrix<T>::AllocateMemory(bool zero) {
+  AllocateBlock(Size(), zero);
+}
+
+template <typename T>
+void S21BasicMatrix<T>::AllocateBlock(std::size_t size, bool zero) {
+  block_size_ = size;
+  if (block_size_ == 0) {
+    matrix_ = nullptr;
+    allocator_ = nullptr;
+    return;
   }
-  if (temp.rows_ == 2) {
-    result = temp.matrix_[0][0] * temp.matrix_[1][1] -
-             temp.matrix_[0][1] * temp.matrix_[1][0];
+  if (block_size_ <= kInlineCapacity) {
+    matrix_ = inline_;
+    allocator_ = nullptr;
   } else {
-    result = Triangle(temp.matrix_, temp.rows_);
+    allocator_ = S21MatrixAllocator::Current();
+    matrix_ =
+        static_cast<T*>(allocator_->Allocate(block_size_ * sizeof(T)));
+    S21_MATRIX_ALLOC(block_size_ * sizeof(T));
+  }
+  if (zero) std::fill(matrix_, matrix_ + block_size_, T(0));
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicMatrix<T>::Product(
+    const S21BasicMatrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
   }
+  S21_MATRIX_OP(kMulMatrix, 2.0 * rows_ * other.cols_ * cols_);
+  S21BasicMatrix result(rows_, other.cols_);
+  s21::Gemm(rows_, other.cols_, cols_, matrix_, cols_, 1, other.matrix_,
+            other.cols_, 1, result.matrix_, result.cols_);
   return result;
 }
 
-double S21Matrix::Triangle(double** matrix, int size) {
-  int flag = 1;
-  double result = 1;
+// Блок из кучи передаётся указателем, встроенный копируется
+template <typename T>
+void S21BasicMatrix<T>::TakeStorage(S21BasicMatrix& other) noexcept {
+  rows_ = other.rows_;
+  cols_ = other.cols_;
+  allocator_ = other.allocator_;
+  block_size_ = other.block_size_;
+  if (other.matrix_ == other.inline_) {
+    std::memcpy(inline_, other.inline_, block_size_ * sizeof(T));
+    matrix_ = inline_;
+  } else {
+    matrix_ = other.matrix_;
+  }
+  other.rows_ = 0;
+  other.cols_ = 0;
+  other.matrix_ = nullptr;
+  other.allocator_ = nullptr;
+  other.block_size_ = 0;
+}
 
-  for (int k = 0; k < size - 1; k++) {
-    if (!matrix[k][k]) {
-      flag = ChangeRows(matrix, k, size);
+template <typename T>
+void S21BasicMatrix<T>::Regrow(std::size_t capacity, int cols) {
+  S21BasicMatrix grown;
+  grown.AllocateBlock(capacity, false);
+  grown.rows_ = rows_;
+  grown.cols_ = cols;
+  const int common = std::min(cols_, cols);
+  for (int i = 0; i < rows_; i++) {
+    T* row = grown.matrix_ + grown.Offset(i, 0);
+    if (common > 0) {
+      std::memcpy(row, matrix_ + Offset(i, 0), sizeof(T) * common);
     }
-    if (!flag) {
-      result = 0;
-      break;
-    } else {
-      for (int i = k + 1; i < size; i++) {
-        double kkk = matrix[i][k];
-        if (kkk) {
-          for (int j = k; j < size; j++) {
-            matrix[i][j] = matrix[i][j] - matrix[k][j] * kkk / matrix[k][k];
-          }
-        }
-      }
+    std::fill(row + common, row + cols, T(0));
+  }
+  *this = std::move(grown);
+}
+
+// Строки сдвигаются внутри блока: при укорочении вперёд, начиная с первой,
+// при удлинении назад, начиная с последней, чтобы не затереть ещё
+// не перенесённые строки
+template <typename T>
+void S21BasicMatrix<T>::Repack(int cols) {
+  if (cols < cols_) {
+    for (int i = 1; i < rows_; i++) {
+      std::memmove(matrix_ + static_cast<std::size_t>(i) * cols,
+                   matrix_ + Offset(i, 0), sizeof(T) * cols);
+    }
+  } else {
+    for (int i = rows_ - 1; i >= 0; i--) {
+      T* row = matrix_ + static_cast<std::size_t>(i) * cols;
+      std::memmove(row, matrix_ + Offset(i, 0), sizeof(T) * cols_);
+      std::fill(row + cols_, row + cols, T(0));
     }
   }
-  if (result) {
-    for (int i = 0; i < size; i++) {
-      result *= matrix[i][i];
+  cols_ = cols;
+}
+
+template <typename T>
+std::size_t S21BasicMatrix<T>::Size() const {
+  return static_cast<std::size_t>(rows_) * cols_;
+}
+
+template <typename T>
+T S21BasicMatrix<T>::MaxAbs() const {
+  T result = 0;
+  for (int i = 0; i < rows_; i++) {
+    for (int j = 0; j < cols_; j++) {
+      result = std::max(result, std::fabs(matrix_[Offset(i, j)]));
     }
   }
   return result;
 }
 
-int S21Matrix::ChangeRows(double** matrix, int k, int size) {
-  int flag = 0;
-  int i = k + 1;
-  double temp;
-  while (!matrix[k][k] && i < size) {
-    for (int j = k; j < size; j++) {
-      temp = matrix[k][j];
-      matrix[k][j] = matrix[i][j];
-      matrix[i][j] = -temp;
-      if (matrix[k][k]) flag = 1;
+template <typename T>
+void S21BasicMatrix<T>::FreeingMemory() {
+  if (matrix_ && matrix_ != inline_) {
+    allocator_->Deallocate(matrix_, block_size_ * sizeof(T));
+  }
+  matrix_ = nullptr;
+  allocator_ = nullptr;
+  block_size_ = 0;
+}
+
+template <typename T>
+void S21BasicMatrix<T>::CopyMatrix(const T* sourse) {
+  if (matrix_) std::memcpy(matrix_, sourse, sizeof(T) * Size());
+}
+
+// Минор без строки x и столбца y в буфере scratch из (n - 1)^2 элементов
+template <typename T>
+T S21BasicMatrix<T>::Minor(int x, int y, T* scratch) const {
+  const int size = rows_ - 1;
+  T* t = scratch;
+  for (int i = 0; i < rows_; i++) {
+    if (i == x) continue;
+    const T* row = matrix_ + Offset(i, 0);
+    for (int j = 0; j < cols_; j++) {
+      if (j != y) *t++ = row[j];
     }
-    if (flag) break;
-    i++;
   }
-  return flag;
+  if (size == 2) {
+    return scratch[0] * scratch[3] - scratch[1] * scratch[2];
+  }
+  T result = s21::small_matrix::LuDecompose(scratch, size, size, nullptr);
+  for (int i = 0; result && i < size; i++) {
+    result *= scratch[static_cast<std::size_t>(i) * size + i];
+  }
+  return result;
 }
+
+template class S21BasicMatrix<float>;
+template class S21BasicMatrix<double>;
+template class S21BasicMatrix<long double>;
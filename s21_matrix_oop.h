@@ -2,62 +2,409 @@
 #define MATRIX_SRC_S21_MATRIX_OOP_H
 
 #include <cmath>
+#include <cstddef>
 #include <exception>
 #include <iostream>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "s21_matrix_allocator.h"
+#include "s21_matrix_expr.h"
+#include "s21_matrix_view.h"
+
+template <typename T>
+class S21BasicLU;
+
+template <typename T>
+class S21BasicSparseMatrix;
+
+// Допуск поэлементного сравнения в EqMatrix для каждого типа элементов
+template <typename T>
+struct S21MatrixTraits;
+
+template <>
+struct S21MatrixTraits<float> {
+  static constexpr float kEpsilon = 1E-04f;
+};
+
+template <>
+struct S21MatrixTraits<double> {
+  static constexpr double kEpsilon = 1E-07;
+};
+
+template <>
+struct S21MatrixTraits<long double> {
+  static constexpr long double kEpsilon = 1E-10L;
+};
+
+// Матрица с элементами типа T (float, double или long double).
+// Реализация инстанцируется явно в s21_matrix_oop.cpp для этих трёх типов.
+template <typename T>
+class S21BasicMatrix : public S21MatrixExpr<S21BasicMatrix<T>> {
+  friend class S21BasicLU<T>;
+  friend class S21BasicSparseMatrix<T>;
+  friend class S21MatrixExpr<S21BasicMatrix>;
 
-class S21Matrix {
  private:
+  // Элементы хранятся одним выровненным блоком построчно без промежутков:
+  // элемент (i, j) лежит по адресу matrix_[i * cols_ + j].
+  // Блок из block_size_ элементов возвращается выделившему его allocator_;
+  // элементы занимают его начало, остаток — запас для роста матрицы.
+  // Матрицы до kInlineCapacity элементов хранятся в самом объекте
+  // (matrix_ == inline_, allocator_ == nullptr) и не обращаются к куче.
+  static constexpr std::size_t kInlineCapacity = 16;
+
   int rows_, cols_;
-  double** matrix_;
+  T* matrix_;
+  S21MatrixAllocator* allocator_;
+  std::size_t block_size_;
+  alignas(S21MatrixAllocator::kAlignment) T inline_[kInlineCapacity];
 
  public:
+  using value_type = T;
+  static constexpr bool kMayAlias = false;
+  static constexpr T kEpsilon = S21MatrixTraits<T>::kEpsilon;
+  // Порог рекурсии MulMatrixStrassen по умолчанию: блоки порядка 512
+  // Gemm умножает быстрее, чем семь их половин
+  static constexpr int kStrassenThreshold = 768;
+
   // Конструкторы и деструктор
-  S21Matrix();
-  S21Matrix(int rows, int cols);
-  S21Matrix(const S21Matrix& other);
-  S21Matrix(S21Matrix&& other) noexcept;
-  ~S21Matrix();
+  S21BasicMatrix();
+  S21BasicMatrix(int rows, int cols);
+  S21BasicMatrix(const S21BasicMatrix& other);
+  S21BasicMatrix(S21BasicMatrix&& other) noexcept;
+  // Вычисление поэлементного выражения (A + B - 2.0 * C) за один проход
+  template <typename E, typename = std::enable_if_t<
+                            !std::is_same<E, S21BasicMatrix>::value>>
+  S21BasicMatrix(const S21MatrixExpr<E>& expr);
+  ~S21BasicMatrix();
 
   // Базовые функции для работы с матрицами
-  bool EqMatrix(const S21Matrix& other);
-  void SumMatrix(const S21Matrix& other);
-  void SubMatrix(const S21Matrix& other);
-  void MulNumber(const double num);
-  void MulMatrix(const S21Matrix& other);
-  S21Matrix Transpose();
-  S21Matrix CalcComplements();
-  double Determinant();
-  S21Matrix InverseMatrix();
+  bool EqMatrix(const S21BasicMatrix& other) const;
+  void SumMatrix(const S21BasicMatrix& other);
+  void SubMatrix(const S21BasicMatrix& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicMatrix& other);
+  void SumMatrix(const S21BasicMatrixView<T>& other);
+  void SubMatrix(const S21BasicMatrixView<T>& other);
+  void MulMatrix(const S21BasicMatrixView<T>& other);
+  // Умножение по схеме Штрассена–Винограда (s21::StrassenGemm): для
+  // крупных произведений быстрее MulMatrix, но ошибка округления больше
+  void MulMatrixStrassen(const S21BasicMatrix& other,
+                         int threshold = kStrassenThreshold);
+  // Оценки сверху max|C - fl(C)| для C = *this * other (первого порядка
+  // по машинной точности, Higham, «Accuracy and Stability of Numerical
+  // Algorithms», гл. 23): классического MulMatrix и MulMatrixStrassen
+  T MulErrorBound(const S21BasicMatrix& other);
+  T StrassenErrorBound(const S21BasicMatrix& other,
+                       int threshold = kStrassenThreshold);
+  S21BasicMatrix Transpose();
+  // Для квадратной матрицы — без выделения памяти
+  void TransposeInPlace();
+  S21BasicMatrix CalcComplements();
+  T Determinant();
+  S21BasicMatrix InverseMatrix();
+  // LU-разложение для многократного решения систем с этой матрицей
+  S21BasicLU<T> LU();
 
   // Перегрузка операторов
-  S21Matrix& operator=(const S21Matrix& x);
-  S21Matrix& operator=(S21Matrix&& x) noexcept;
-  bool operator==(const S21Matrix& x);
-  S21Matrix operator+(const S21Matrix& x);
-  S21Matrix operator-(const S21Matrix& x);
-  S21Matrix operator*(const S21Matrix& x);
-  friend S21Matrix operator*(const double x, const S21Matrix& y);
-  S21Matrix operator*(double x);
-  S21Matrix& operator+=(const S21Matrix& x);
-  S21Matrix& operator-=(const S21Matrix& x);
-  S21Matrix& operator*=(const S21Matrix& x);
-  S21Matrix& operator*=(const double x);
-  double& operator()(int i, int j);
+  S21BasicMatrix& operator=(const S21BasicMatrix& x);
+  S21BasicMatrix& operator=(S21BasicMatrix&& x) noexcept;
+  template <typename E, typename = std::enable_if_t<
+                            !std::is_same<E, S21BasicMatrix>::value>>
+  S21BasicMatrix& operator=(const S21MatrixExpr<E>& expr);
+  // +, - и умножение на число — ленивые выражения из s21_matrix_expr.h,
+  // для временных матриц — перегрузки ниже, переиспользующие их память.
+  // * и == — свободные функции ниже: операндом может быть и выражение
+  template <typename L, typename R>
+  friend S21BasicMatrix<typename L::value_type> operator*(
+      const S21MatrixExpr<L>& x, const S21MatrixExpr<R>& y);
+  S21BasicMatrix& operator+=(const S21BasicMatrix& x);
+  S21BasicMatrix& operator-=(const S21BasicMatrix& x);
+  template <typename E, typename = std::enable_if_t<
+                            !std::is_same<E, S21BasicMatrix>::value>>
+  S21BasicMatrix& operator+=(const S21MatrixExpr<E>& x);
+  template <typename E, typename = std::enable_if_t<
+                            !std::is_same<E, S21BasicMatrix>::value>>
+  S21BasicMatrix& operator-=(const S21MatrixExpr<E>& x);
+  S21BasicMatrix& operator*=(const S21BasicMatrix& x);
+  S21BasicMatrix& operator*=(const T x);
+  T& operator()(int i, int j);
+  T operator()(int i, int j) const;
+
+  // Доступ без проверки индексов для горячих циклов: индексы проверяет
+  // вызывающий, тело встраивается и не мешает векторизации
+  T& At(int i, int j) { return matrix_[Offset(i, j)]; }
+  const T& At(int i, int j) const { return matrix_[Offset(i, j)]; }
+  // Строка i — GetCols() элементов подряд; индекс проверяется один раз
+  S21Span<T> Row(int i);
+  S21Span<const T> Row(int i) const;
+  // GetRows() * GetCols() элементов построчно без промежутков: хранение
+  // всегда сплошное, обе версии только возвращают указатель. Указатель
+  // действителен до изменения размеров матрицы
+  T* Data();
+  const T* Data() const;
+
+  // Окна без копирования: вся матрица, строка, столбец, блок, транспонированная
+  S21BasicMatrixView<T> View();
+  S21BasicMatrixView<T> RowView(int i);
+  S21BasicMatrixView<T> ColView(int j);
+  S21BasicMatrixView<T> BlockView(int row, int col, int rows, int cols);
+  S21BasicMatrixView<T> TransposedView();
 
   // Геттеры и сеттеры
-  int GetRows();
-  int GetCols();
+  int GetRows() const;
+  int GetCols() const;
+  // Размеры меняются в пределах ёмкости блока без перевыделения:
+  // уменьшение сохраняет блок, рост сверх ёмкости увеличивает её
+  // геометрически (вдвое), новые строки и столбцы заполняются нулями.
+  // Строки всегда лежат подряд: SetCols переносит их внутри блока
   void SetRows(int rows);
   void SetCols(int cols);
+  // Сколько строк (столбцов) помещается в блок при текущем числе
+  // столбцов (строк)
+  int GetRowCapacity() const;
+  int GetColCapacity() const;
+  // Блок не меньше rows x cols элементов; размеры матрицы не меняются
+  void Reserve(int rows, int cols);
+  // Отдаёт неиспользуемую ёмкость: блок ровно rows x cols
+  void ShrinkToFit();
+  // Дописывает строку в запас ёмкости; пустая матрица получает
+  // values.size() столбцов
+  void AppendRow(const std::vector<T>& values);
+
+  // Двоичный файл формата s21_matrix_io.h
+  void Save(const std::string& path) const;
+  static S21BasicMatrix Load(const std::string& path);
+  // Матрица поверх отображённого в память файла Save: данные не читаются
+  // и не копируются, процессы делят страницы файла (s21::io::MappedFile)
+  static S21BasicMatrix Map(const std::string& path);
+
+  // Число потоков для MulMatrix (0 — по числу аппаратных потоков).
+  // Результат не зависит от числа потоков.
+  static void SetThreadCount(int count);
+  static int GetThreadCount();
 
  private:
+  // Смещение элемента (i, j) от начала блока; считается в size_t,
+  // чтобы не переполняться у матриц больше 2^31 элементов
+  std::size_t Offset(int i, int j) const {
+    return static_cast<std::size_t>(i) * cols_ + j;
+  }
   // Вспомогательные функции
-  void CopyMatrix(double** sourse);
-  void AllocateMemory();
+  void CopyMatrix(const T* sourse);
+  void AllocateMemory(bool zero = true);
+  void AllocateBlock(std::size_t size, bool zero);
   void FreeingMemory();
-  double Minor(int x, int y);
-  double Triangle(double** matrix, int size);
-  int ChangeRows(double** matrix, int k, int size);
+  void TakeStorage(S21BasicMatrix& other) noexcept;
+  // Переносит элементы в новый блок из capacity элементов со строками
+  // длины cols; новые столбцы заполняются нулями
+  void Regrow(std::size_t capacity, int cols);
+  // То же внутри текущего блока, если rows_ * cols в нём помещается
+  void Repack(int cols);
+  S21BasicMatrix Product(const S21BasicMatrix& other) const;
+  // Transpose без учёта в счётчиках s21::stats
+  S21BasicMatrix Transposed() const;
+  std::size_t Size() const;
+  T MaxAbs() const;
+  T Minor(int x, int y, T* scratch) const;
+
+  // Интерфейс листа выражения
+  int ExprRows() const { return rows_; }
+  int ExprCols() const { return cols_; }
+  T ExprEval(int i, int j) const { return matrix_[Offset(i, j)]; }
+
+  template <typename E, typename Op>
+  void EvalInto(const S21MatrixExpr<E>& expr, Op op);
 };
 
+using S21Matrix = S21BasicMatrix<double>;
+
+template <typename T>
+template <typename E, typename Op>
+void S21BasicMatrix<T>::EvalInto(const S21MatrixExpr<E>& expr, Op op) {
+  static_assert(std::is_same<typename E::value_type, T>::value,
+                "Element types of matrices are different");
+  const E& e = expr.Self();
+  for (int i = 0; i < rows_; i++) {
+    T* row = matrix_ + Offset(i, 0);
+    for (int j = 0; j < cols_; j++) {
+      op(row[j], e.ExprEval(i, j));
+    }
+  }
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>::S21BasicMatrix(const S21MatrixExpr<E>& expr)
+    : rows_(expr.Rows()), cols_(expr.Cols()) {
+  AllocateMemory(false);
+  EvalInto(expr, [](T& dst, T value) { dst = value; });
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator=(const S21MatrixExpr<E>& expr) {
+  if (E::kMayAlias || rows_ != expr.Rows() || cols_ != expr.Cols()) {
+    // Выражение может ссылаться на эту матрицу: сначала вычисляем
+    *this = S21BasicMatrix(expr);
+  } else {
+    EvalInto(expr, [](T& dst, T value) { dst = value; });
+  }
+  return *this;
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator+=(const S21MatrixExpr<E>& x) {
+  if (rows_ != x.Rows() || cols_ != x.Cols()) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  if constexpr (E::kMayAlias) return *this += S21BasicMatrix(x);
+  EvalInto(x, [](T& dst, T value) { dst += value; });
+  return *this;
+}
+
+template <typename T>
+template <typename E, typename>
+S21BasicMatrix<T>& S21BasicMatrix<T>::operator-=(const S21MatrixExpr<E>& x) {
+  if (rows_ != x.Rows() || cols_ != x.Cols()) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  if constexpr (E::kMayAlias) return *this -= S21BasicMatrix(x);
+  EvalInto(x, [](T& dst, T value) { dst -= value; });
+  return *this;
+}
+
+// Операнд-матрица берётся как есть, выражение и окно вычисляются
+// в новую матрицу
+template <typename T>
+const S21BasicMatrix<T>& S21Evaluated(const S21BasicMatrix<T>& x) {
+  return x;
+}
+
+template <typename E>
+S21BasicMatrix<typename E::value_type> S21Evaluated(
+    const S21MatrixExpr<E>& x) {
+  return S21BasicMatrix<typename E::value_type>(x);
+}
+
+// Произведение матриц; (A - B) * C вычисляет A - B один раз
+template <typename L, typename R>
+S21BasicMatrix<typename L::value_type> operator*(const S21MatrixExpr<L>& x,
+                                                 const S21MatrixExpr<R>& y) {
+  static_assert(
+      std::is_same<typename L::value_type, typename R::value_type>::value,
+      "Element types of matrices are different");
+  const auto& a = S21Evaluated(x.Self());
+  const auto& b = S21Evaluated(y.Self());
+  return a.Product(b);
+}
+
+template <typename L, typename R>
+bool operator==(const S21MatrixExpr<L>& x, const S21MatrixExpr<R>& y) {
+  static_assert(
+      std::is_same<typename L::value_type, typename R::value_type>::value,
+      "Element types of matrices are different");
+  return S21Evaluated(x.Self()).EqMatrix(S21Evaluated(y.Self()));
+}
+
+// Операции с временной матрицей-операндом записывают результат в её буфер
+template <typename T>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& x, S21BasicMatrix<T>&& y) {
+  x.SumMatrix(y);
+  return std::move(x);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& x, S21BasicMatrix<T>&& y) {
+  x.SubMatrix(y);
+  return std::move(x);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(S21BasicMatrix<T>&& x,
+                            typename S21BasicMatrix<T>::value_type y) {
+  x.MulNumber(y);
+  return std::move(x);
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(typename S21BasicMatrix<T>::value_type x,
+                            S21BasicMatrix<T>&& y) {
+  y.MulNumber(x);
+  return std::move(y);
+}
+
+template <typename T, typename R>
+S21BasicMatrix<T> operator+(S21BasicMatrix<T>&& x, const S21MatrixExpr<R>& y) {
+  x += y.Self();
+  return std::move(x);
+}
+
+template <typename T, typename L>
+S21BasicMatrix<T> operator+(const S21MatrixExpr<L>& x, S21BasicMatrix<T>&& y) {
+  y = x.Self() + y;
+  return std::move(y);
+}
+
+template <typename T, typename R>
+S21BasicMatrix<T> operator-(S21BasicMatrix<T>&& x, const S21MatrixExpr<R>& y) {
+  x -= y.Self();
+  return std::move(x);
+}
+
+template <typename T, typename L>
+S21BasicMatrix<T> operator-(const S21MatrixExpr<L>& x, S21BasicMatrix<T>&& y) {
+  y = x.Self() - y;
+  return std::move(y);
+}
+
+// LU-разложение с частичным выбором ведущего элемента: P * A = L * U.
+// Разложение стоит O(n^3) и выполняется один раз в конструкторе,
+// каждое решение системы после этого стоит O(n^2) на столбец правой части.
+template <typename T>
+class S21BasicLU {
+ public:
+  explicit S21BasicLU(const S21BasicMatrix<T>& matrix);
+  explicit S21BasicLU(S21BasicMatrix<T>&& matrix);
+  explicit S21BasicLU(const S21BasicMatrixView<T>& matrix);
+
+  int GetSize() const;
+  // Ведущий элемент пренебрежимо мал по сравнению с масштабами своей
+  // строки и столбца (HasNegligiblePivot в s21_matrix_small.h);
+  // Solve, Inverse и Cofactors для такой матрицы бросают исключение
+  bool IsSingular() const;
+  // Знак перестановки, умноженный на произведение диагонали U
+  T Determinant() const;
+
+  // Решение A * x = b для одного вектора и для всех столбцов B сразу
+  std::vector<T> Solve(const std::vector<T>& b) const;
+  S21BasicMatrix<T> Solve(const S21BasicMatrix<T>& b) const;
+
+  // Обратная матрица; у временного объекта переиспользует его память
+  S21BasicMatrix<T> Inverse() const&;
+  S21BasicMatrix<T> Inverse() &&;
+  // Матрица алгебраических дополнений det(A) * inv(A)^T; столбцы
+  // обратной матрицы решаются блоками параллельно в S21ThreadPool
+  S21BasicMatrix<T> Cofactors() const;
+
+ private:
+  void Factorize();
+  void CheckSingular() const;
+  // Решение A * X = B на месте строк B (cols столбцов с шагом xs)
+  void SolveInPlace(T* data, int cols, std::size_t xs) const;
+  void InvertInPlace();
+
+  S21BasicMatrix<T> lu_;
+  std::vector<int> pivots_;
+  int sign_;
+  bool singular_;
+};
+
+using S21LU = S21BasicLU<double>;
+
 #endif  // MATRIX_SRC_S21_MATRIX_OOP_H
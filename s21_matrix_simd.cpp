@@ -0,0 +1,804 @@
+#include "s21_matrix_simd.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <initializer_list>
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define S21_SIMD_X86 1
+#include <immintrin.h>
+#endif
+
+namespace s21 {
+namespace simd {
+
+namespace {
+
+template <typename T>
+struct Kernels {
+  void (*add)(T*, const T*, std::size_t);
+  void (*sub)(T*, const T*, std::size_t);
+  void (*scale)(T*, T, std::size_t);
+  void (*axpy)(T*, T, const T*, std::size_t);
+  bool (*equal)(const T*, const T*, std::size_t, T);
+  // Транспонирование плитки rows x cols: dst[j * ds + i] = src[i * ss + j]
+  void (*transpose_tile)(const T*, int, int, std::ptrdiff_t, T*,
+                         std::ptrdiff_t);
+};
+
+// Сторона плитки транспонирования: две плитки 32 x 32 занимают 16 КБ
+// и вместе с приёмником помещаются в L1
+constexpr int kTransposeTile = 32;
+
+/////////////          Скалярные ядра        /////////////////
+
+template <typename T>
+void AddScalar(T* a, const T* b, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) a[i] += b[i];
+}
+
+template <typename T>
+void SubScalar(T* a, const T* b, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) a[i] -= b[i];
+}
+
+template <typename T>
+void ScaleScalar(T* a, T num, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) a[i] *= num;
+}
+
+template <typename T>
+void AxpyScalar(T* a, T num, const T* b, std::size_t count) {
+  for (std::size_t i = 0; i < count; i++) a[i] += num * b[i];
+}
+
+template <typename T>
+bool EqualScalar(const T* a, const T* b, std::size_t count, T eps) {
+  for (std::size_t i = 0; i < count; i++) {
+    if (std::fabs(a[i] - b[i]) > eps) return false;
+  }
+  return true;
+}
+
+template <typename T>
+void TransposeTileScalar(const T* src, int rows, int cols, std::ptrdiff_t ss,
+                         T* dst, std::ptrdiff_t ds) {
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      dst[j * ds + i] = src[i * ss + j];
+    }
+  }
+}
+
+// Дотранспонирование краёв плитки, не покрытых блоками block x block
+template <typename T>
+void TransposeTileEdges(const T* src, int rows, int cols, std::ptrdiff_t ss,
+                        T* dst, std::ptrdiff_t ds, int block) {
+  const int full_rows = rows / block * block;
+  const int full_cols = cols / block * block;
+  TransposeTileScalar(src + full_cols, full_rows, cols - full_cols, ss,
+                      dst + full_cols * ds, ds);
+  TransposeTileScalar(src + full_rows * ss, rows - full_rows, cols, ss,
+                      dst + full_rows, ds);
+}
+
+template <typename T>
+constexpr Kernels<T> kScalarKernels = {AddScalar<T>, SubScalar<T>,
+                                       ScaleScalar<T>, AxpyScalar<T>,
+                                       EqualScalar<T>, TransposeTileScalar<T>};
+
+#ifdef S21_SIMD_X86
+
+/////////////          SSE2        /////////////////
+
+void AddSse2(double* a, const double* b, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(a + i, _mm_add_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  AddScalar(a + i, b + i, count - i);
+}
+
+void SubSse2(double* a, const double* b, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(a + i, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+  }
+  SubScalar(a + i, b + i, count - i);
+}
+
+void ScaleSse2(double* a, double num, std::size_t count) {
+  const __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(a + i, _mm_mul_pd(_mm_loadu_pd(a + i), factor));
+  }
+  ScaleScalar(a + i, num, count - i);
+}
+
+void AxpySse2(double* a, double num, const double* b, std::size_t count) {
+  const __m128d factor = _mm_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    _mm_storeu_pd(a + i, _mm_add_pd(_mm_loadu_pd(a + i),
+                                    _mm_mul_pd(_mm_loadu_pd(b + i), factor)));
+  }
+  AxpyScalar(a + i, num, b + i, count - i);
+}
+
+bool EqualSse2(const double* a, const double* b, std::size_t count,
+               double eps) {
+  const __m128d sign = _mm_set1_pd(-0.0);
+  const __m128d limit = _mm_set1_pd(eps);
+  std::size_t i = 0;
+  for (; i + 2 <= count; i += 2) {
+    const __m128d diff =
+        _mm_andnot_pd(sign, _mm_sub_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+    if (_mm_movemask_pd(_mm_cmpgt_pd(diff, limit))) return false;
+  }
+  return EqualScalar(a + i, b + i, count - i, eps);
+}
+
+// Блоки 2 x 2 транспонируются в регистрах распаковкой половин
+void TransposeTileSse2(const double* src, int rows, int cols, std::ptrdiff_t ss,
+                       double* dst, std::ptrdiff_t ds) {
+  for (int i = 0; i + 2 <= rows; i += 2) {
+    for (int j = 0; j + 2 <= cols; j += 2) {
+      const __m128d r0 = _mm_loadu_pd(src + i * ss + j);
+      const __m128d r1 = _mm_loadu_pd(src + (i + 1) * ss + j);
+      _mm_storeu_pd(dst + j * ds + i, _mm_unpacklo_pd(r0, r1));
+      _mm_storeu_pd(dst + (j + 1) * ds + i, _mm_unpackhi_pd(r0, r1));
+    }
+  }
+  TransposeTileEdges(src, rows, cols, ss, dst, ds, 2);
+}
+
+void AddSse2(float* a, const float* b, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  AddScalar(a + i, b + i, count - i);
+}
+
+void SubSse2(float* a, const float* b, std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(a + i, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+  }
+  SubScalar(a + i, b + i, count - i);
+}
+
+void ScaleSse2(float* a, float num, std::size_t count) {
+  const __m128 factor = _mm_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(a + i, _mm_mul_ps(_mm_loadu_ps(a + i), factor));
+  }
+  ScaleScalar(a + i, num, count - i);
+}
+
+void AxpySse2(float* a, float num, const float* b, std::size_t count) {
+  const __m128 factor = _mm_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    _mm_storeu_ps(a + i, _mm_add_ps(_mm_loadu_ps(a + i),
+                                    _mm_mul_ps(_mm_loadu_ps(b + i), factor)));
+  }
+  AxpyScalar(a + i, num, b + i, count - i);
+}
+
+bool EqualSse2(const float* a, const float* b, std::size_t count, float eps) {
+  const __m128 sign = _mm_set1_ps(-0.0f);
+  const __m128 limit = _mm_set1_ps(eps);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m128 diff =
+        _mm_andnot_ps(sign, _mm_sub_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    if (_mm_movemask_ps(_mm_cmpgt_ps(diff, limit))) return false;
+  }
+  return EqualScalar(a + i, b + i, count - i, eps);
+}
+
+// Блоки 4 x 4 float транспонируются в регистрах макросом _MM_TRANSPOSE4_PS
+void TransposeTileSse2(const float* src, int rows, int cols, std::ptrdiff_t ss,
+                       float* dst, std::ptrdiff_t ds) {
+  for (int i = 0; i + 4 <= rows; i += 4) {
+    for (int j = 0; j + 4 <= cols; j += 4) {
+      const float* s0 = src + i * ss + j;
+      __m128 r0 = _mm_loadu_ps(s0);
+      __m128 r1 = _mm_loadu_ps(s0 + ss);
+      __m128 r2 = _mm_loadu_ps(s0 + 2 * ss);
+      __m128 r3 = _mm_loadu_ps(s0 + 3 * ss);
+      _MM_TRANSPOSE4_PS(r0, r1, r2, r3);
+      float* d0 = dst + j * ds + i;
+      _mm_storeu_ps(d0, r0);
+      _mm_storeu_ps(d0 + ds, r1);
+      _mm_storeu_ps(d0 + 2 * ds, r2);
+      _mm_storeu_ps(d0 + 3 * ds, r3);
+    }
+  }
+  TransposeTileEdges(src, rows, cols, ss, dst, ds, 4);
+}
+
+template <typename T>
+constexpr Kernels<T> kSse2Kernels = {AddSse2,   SubSse2,   ScaleSse2,
+                                     AxpySse2,  EqualSse2, TransposeTileSse2};
+
+/////////////          AVX2        /////////////////
+
+__attribute__((target("avx2"))) void AddAvx2(double* a, const double* b,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256d x0 = _mm256_add_pd(_mm256_loadu_pd(a + i),
+                                     _mm256_loadu_pd(b + i));
+    const __m256d x1 = _mm256_add_pd(_mm256_loadu_pd(a + i + 4),
+                                     _mm256_loadu_pd(b + i + 4));
+    _mm256_storeu_pd(a + i, x0);
+    _mm256_storeu_pd(a + i + 4, x1);
+  }
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(
+        a + i, _mm256_add_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  }
+  AddScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(double* a, const double* b,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256d x0 = _mm256_sub_pd(_mm256_loadu_pd(a + i),
+                                     _mm256_loadu_pd(b + i));
+    const __m256d x1 = _mm256_sub_pd(_mm256_loadu_pd(a + i + 4),
+                                     _mm256_loadu_pd(b + i + 4));
+    _mm256_storeu_pd(a + i, x0);
+    _mm256_storeu_pd(a + i + 4, x1);
+  }
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(
+        a + i, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+  }
+  SubScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(double* a, double num,
+                                               std::size_t count) {
+  const __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256d x0 = _mm256_mul_pd(_mm256_loadu_pd(a + i), factor);
+    const __m256d x1 = _mm256_mul_pd(_mm256_loadu_pd(a + i + 4), factor);
+    _mm256_storeu_pd(a + i, x0);
+    _mm256_storeu_pd(a + i + 4, x1);
+  }
+  for (; i + 4 <= count; i += 4) {
+    _mm256_storeu_pd(a + i, _mm256_mul_pd(_mm256_loadu_pd(a + i), factor));
+  }
+  ScaleScalar(a + i, num, count - i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(double* a, double num,
+                                              const double* b,
+                                              std::size_t count) {
+  const __m256d factor = _mm256_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256d x0 = _mm256_add_pd(
+        _mm256_loadu_pd(a + i), _mm256_mul_pd(_mm256_loadu_pd(b + i), factor));
+    const __m256d x1 =
+        _mm256_add_pd(_mm256_loadu_pd(a + i + 4),
+                      _mm256_mul_pd(_mm256_loadu_pd(b + i + 4), factor));
+    _mm256_storeu_pd(a + i, x0);
+    _mm256_storeu_pd(a + i + 4, x1);
+  }
+  for (; i + 4 <= count; i += 4) {
+    const __m256d product = _mm256_mul_pd(_mm256_loadu_pd(b + i), factor);
+    _mm256_storeu_pd(a + i, _mm256_add_pd(_mm256_loadu_pd(a + i), product));
+  }
+  AxpyScalar(a + i, num, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const double* a,
+                                               const double* b,
+                                               std::size_t count, double eps) {
+  const __m256d sign = _mm256_set1_pd(-0.0);
+  const __m256d limit = _mm256_set1_pd(eps);
+  std::size_t i = 0;
+  for (; i + 4 <= count; i += 4) {
+    const __m256d diff = _mm256_andnot_pd(
+        sign, _mm256_sub_pd(_mm256_loadu_pd(a + i), _mm256_loadu_pd(b + i)));
+    if (_mm256_movemask_pd(_mm256_cmp_pd(diff, limit, _CMP_GT_OQ))) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, count - i, eps);
+}
+
+// Блоки 4 x 4 транспонируются в регистрах: распаковка пар строк
+// и перестановка 128-битных половин
+__attribute__((target("avx2"))) void TransposeTileAvx2(const double* src,
+                                                       int rows, int cols,
+                                                       std::ptrdiff_t ss,
+                                                       double* dst,
+                                                       std::ptrdiff_t ds) {
+  for (int i = 0; i + 4 <= rows; i += 4) {
+    for (int j = 0; j + 4 <= cols; j += 4) {
+      const double* s0 = src + i * ss + j;
+      const __m256d r0 = _mm256_loadu_pd(s0);
+      const __m256d r1 = _mm256_loadu_pd(s0 + ss);
+      const __m256d r2 = _mm256_loadu_pd(s0 + 2 * ss);
+      const __m256d r3 = _mm256_loadu_pd(s0 + 3 * ss);
+      const __m256d t0 = _mm256_unpacklo_pd(r0, r1);
+      const __m256d t1 = _mm256_unpackhi_pd(r0, r1);
+      const __m256d t2 = _mm256_unpacklo_pd(r2, r3);
+      const __m256d t3 = _mm256_unpackhi_pd(r2, r3);
+      double* d0 = dst + j * ds + i;
+      _mm256_storeu_pd(d0, _mm256_permute2f128_pd(t0, t2, 0x20));
+      _mm256_storeu_pd(d0 + ds, _mm256_permute2f128_pd(t1, t3, 0x20));
+      _mm256_storeu_pd(d0 + 2 * ds, _mm256_permute2f128_pd(t0, t2, 0x31));
+      _mm256_storeu_pd(d0 + 3 * ds, _mm256_permute2f128_pd(t1, t3, 0x31));
+    }
+  }
+  TransposeTileEdges(src, rows, cols, ss, dst, ds, 4);
+}
+
+__attribute__((target("avx2"))) void AddAvx2(float* a, const float* b,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256 x0 = _mm256_add_ps(_mm256_loadu_ps(a + i),
+                                    _mm256_loadu_ps(b + i));
+    const __m256 x1 = _mm256_add_ps(_mm256_loadu_ps(a + i + 8),
+                                    _mm256_loadu_ps(b + i + 8));
+    _mm256_storeu_ps(a + i, x0);
+    _mm256_storeu_ps(a + i + 8, x1);
+  }
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(
+        a + i, _mm256_add_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+  }
+  AddScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) void SubAvx2(float* a, const float* b,
+                                             std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256 x0 = _mm256_sub_ps(_mm256_loadu_ps(a + i),
+                                    _mm256_loadu_ps(b + i));
+    const __m256 x1 = _mm256_sub_ps(_mm256_loadu_ps(a + i + 8),
+                                    _mm256_loadu_ps(b + i + 8));
+    _mm256_storeu_ps(a + i, x0);
+    _mm256_storeu_ps(a + i + 8, x1);
+  }
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(
+        a + i, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+  }
+  SubScalar(a + i, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) void ScaleAvx2(float* a, float num,
+                                               std::size_t count) {
+  const __m256 factor = _mm256_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256 x0 = _mm256_mul_ps(_mm256_loadu_ps(a + i), factor);
+    const __m256 x1 = _mm256_mul_ps(_mm256_loadu_ps(a + i + 8), factor);
+    _mm256_storeu_ps(a + i, x0);
+    _mm256_storeu_ps(a + i + 8, x1);
+  }
+  for (; i + 8 <= count; i += 8) {
+    _mm256_storeu_ps(a + i, _mm256_mul_ps(_mm256_loadu_ps(a + i), factor));
+  }
+  ScaleScalar(a + i, num, count - i);
+}
+
+__attribute__((target("avx2"))) void AxpyAvx2(float* a, float num,
+                                              const float* b,
+                                              std::size_t count) {
+  const __m256 factor = _mm256_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m256 x0 = _mm256_add_ps(
+        _mm256_loadu_ps(a + i), _mm256_mul_ps(_mm256_loadu_ps(b + i), factor));
+    const __m256 x1 =
+        _mm256_add_ps(_mm256_loadu_ps(a + i + 8),
+                      _mm256_mul_ps(_mm256_loadu_ps(b + i + 8), factor));
+    _mm256_storeu_ps(a + i, x0);
+    _mm256_storeu_ps(a + i + 8, x1);
+  }
+  for (; i + 8 <= count; i += 8) {
+    const __m256 product = _mm256_mul_ps(_mm256_loadu_ps(b + i), factor);
+    _mm256_storeu_ps(a + i, _mm256_add_ps(_mm256_loadu_ps(a + i), product));
+  }
+  AxpyScalar(a + i, num, b + i, count - i);
+}
+
+__attribute__((target("avx2"))) bool EqualAvx2(const float* a, const float* b,
+                                               std::size_t count, float eps) {
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  const __m256 limit = _mm256_set1_ps(eps);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m256 diff = _mm256_andnot_ps(
+        sign, _mm256_sub_ps(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i)));
+    if (_mm256_movemask_ps(_mm256_cmp_ps(diff, limit, _CMP_GT_OQ))) {
+      return false;
+    }
+  }
+  return EqualScalar(a + i, b + i, count - i, eps);
+}
+
+// Для float транспонирование остаётся на блоках 4 x 4 SSE
+template <typename T>
+constexpr Kernels<T> kAvx2Kernels = {AddAvx2,  SubAvx2,   ScaleAvx2,
+                                     AxpyAvx2, EqualAvx2, TransposeTileAvx2};
+
+template <>
+constexpr Kernels<float> kAvx2Kernels<float> = {
+    AddAvx2, SubAvx2, ScaleAvx2, AxpyAvx2, EqualAvx2, TransposeTileSse2};
+
+/////////////          AVX-512        /////////////////
+
+__attribute__((target("avx512f"))) void AddAvx512(double* a, const double* b,
+                                                  std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm512_storeu_pd(
+        a + i, _mm512_add_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+  }
+  if (i < count) {
+    const __mmask8 mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_pd(a + i, mask,
+                          _mm512_add_pd(_mm512_maskz_loadu_pd(mask, a + i),
+                                        _mm512_maskz_loadu_pd(mask, b + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(double* a, const double* b,
+                                                  std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm512_storeu_pd(
+        a + i, _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+  }
+  if (i < count) {
+    const __mmask8 mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_pd(a + i, mask,
+                          _mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + i),
+                                        _mm512_maskz_loadu_pd(mask, b + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(double* a, double num,
+                                                    std::size_t count) {
+  const __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    _mm512_storeu_pd(a + i, _mm512_mul_pd(_mm512_loadu_pd(a + i), factor));
+  }
+  if (i < count) {
+    const __mmask8 mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_pd(
+        a + i, mask, _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, a + i), factor));
+  }
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(double* a, double num,
+                                                   const double* b,
+                                                   std::size_t count) {
+  const __m512d factor = _mm512_set1_pd(num);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m512d product = _mm512_mul_pd(_mm512_loadu_pd(b + i), factor);
+    _mm512_storeu_pd(a + i, _mm512_add_pd(_mm512_loadu_pd(a + i), product));
+  }
+  if (i < count) {
+    const __mmask8 mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+    const __m512d product =
+        _mm512_mul_pd(_mm512_maskz_loadu_pd(mask, b + i), factor);
+    _mm512_mask_storeu_pd(
+        a + i, mask,
+        _mm512_add_pd(_mm512_maskz_loadu_pd(mask, a + i), product));
+  }
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const double* a,
+                                                    const double* b,
+                                                    std::size_t count,
+                                                    double eps) {
+  const __m512d limit = _mm512_set1_pd(eps);
+  std::size_t i = 0;
+  for (; i + 8 <= count; i += 8) {
+    const __m512d diff = _mm512_abs_pd(
+        _mm512_sub_pd(_mm512_loadu_pd(a + i), _mm512_loadu_pd(b + i)));
+    if (_mm512_cmp_pd_mask(diff, limit, _CMP_GT_OQ)) return false;
+  }
+  if (i < count) {
+    const __mmask8 mask = static_cast<__mmask8>((1u << (count - i)) - 1);
+    const __m512d diff =
+        _mm512_abs_pd(_mm512_sub_pd(_mm512_maskz_loadu_pd(mask, a + i),
+                                    _mm512_maskz_loadu_pd(mask, b + i)));
+    if (_mm512_mask_cmp_pd_mask(mask, diff, limit, _CMP_GT_OQ)) return false;
+  }
+  return true;
+}
+
+__attribute__((target("avx512f"))) void AddAvx512(float* a, const float* b,
+                                                  std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    _mm512_storeu_ps(
+        a + i, _mm512_add_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+  }
+  if (i < count) {
+    const __mmask16 mask = static_cast<__mmask16>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_ps(a + i, mask,
+                          _mm512_add_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                        _mm512_maskz_loadu_ps(mask, b + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void SubAvx512(float* a, const float* b,
+                                                  std::size_t count) {
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    _mm512_storeu_ps(
+        a + i, _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+  }
+  if (i < count) {
+    const __mmask16 mask = static_cast<__mmask16>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_ps(a + i, mask,
+                          _mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                        _mm512_maskz_loadu_ps(mask, b + i)));
+  }
+}
+
+__attribute__((target("avx512f"))) void ScaleAvx512(float* a, float num,
+                                                    std::size_t count) {
+  const __m512 factor = _mm512_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    _mm512_storeu_ps(a + i, _mm512_mul_ps(_mm512_loadu_ps(a + i), factor));
+  }
+  if (i < count) {
+    const __mmask16 mask = static_cast<__mmask16>((1u << (count - i)) - 1);
+    _mm512_mask_storeu_ps(
+        a + i, mask, _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, a + i), factor));
+  }
+}
+
+__attribute__((target("avx512f"))) void AxpyAvx512(float* a, float num,
+                                                   const float* b,
+                                                   std::size_t count) {
+  const __m512 factor = _mm512_set1_ps(num);
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m512 product = _mm512_mul_ps(_mm512_loadu_ps(b + i), factor);
+    _mm512_storeu_ps(a + i, _mm512_add_ps(_mm512_loadu_ps(a + i), product));
+  }
+  if (i < count) {
+    const __mmask16 mask = static_cast<__mmask16>((1u << (count - i)) - 1);
+    const __m512 product =
+        _mm512_mul_ps(_mm512_maskz_loadu_ps(mask, b + i), factor);
+    _mm512_mask_storeu_ps(
+        a + i, mask,
+        _mm512_add_ps(_mm512_maskz_loadu_ps(mask, a + i), product));
+  }
+}
+
+__attribute__((target("avx512f"))) bool EqualAvx512(const float* a,
+                                                    const float* b,
+                                                    std::size_t count,
+                                                    float eps) {
+  const __m512 limit = _mm512_set1_ps(eps);
+  std::size_t i = 0;
+  for (; i + 16 <= count; i += 16) {
+    const __m512 diff = _mm512_abs_ps(
+        _mm512_sub_ps(_mm512_loadu_ps(a + i), _mm512_loadu_ps(b + i)));
+    if (_mm512_cmp_ps_mask(diff, limit, _CMP_GT_OQ)) return false;
+  }
+  if (i < count) {
+    const __mmask16 mask = static_cast<__mmask16>((1u << (count - i)) - 1);
+    const __m512 diff =
+        _mm512_abs_ps(_mm512_sub_ps(_mm512_maskz_loadu_ps(mask, a + i),
+                                    _mm512_maskz_loadu_ps(mask, b + i)));
+    if (_mm512_mask_cmp_ps_mask(mask, diff, limit, _CMP_GT_OQ)) return false;
+  }
+  return true;
+}
+
+// Для транспонирования блоки AVX2 / SSE уже упираются в память
+template <typename T>
+constexpr Kernels<T> kAvx512Kernels = {AddAvx512,  SubAvx512,
+                                       ScaleAvx512, AxpyAvx512,
+                                       EqualAvx512, TransposeTileAvx2};
+
+template <>
+constexpr Kernels<float> kAvx512Kernels<float> = {
+    AddAvx512,  SubAvx512,   ScaleAvx512,
+    AxpyAvx512, EqualAvx512, TransposeTileSse2};
+
+#endif  // S21_SIMD_X86
+
+/////////////          Диспетчеризация        /////////////////
+
+bool Supported(Isa isa) {
+#ifdef S21_SIMD_X86
+  __builtin_cpu_init();
+  switch (isa) {
+    case Isa::kScalar:
+    case Isa::kSse2:
+      return true;
+    case Isa::kAvx2:
+      return __builtin_cpu_supports("avx2");
+    case Isa::kAvx512:
+      return __builtin_cpu_supports("avx512f");
+  }
+  return false;
+#else
+  return isa == Isa::kScalar;
+#endif
+}
+
+template <typename T>
+const Kernels<T>* KernelsFor(Isa isa) {
+#ifdef S21_SIMD_X86
+  switch (isa) {
+    case Isa::kAvx512:
+      return &kAvx512Kernels<T>;
+    case Isa::kAvx2:
+      return &kAvx2Kernels<T>;
+    case Isa::kSse2:
+      return &kSse2Kernels<T>;
+    case Isa::kScalar:
+      break;
+  }
+#endif
+  (void)isa;
+  return &kScalarKernels<T>;
+}
+
+Isa BestIsa() {
+  for (Isa isa : {Isa::kAvx512, Isa::kAvx2, Isa::kSse2}) {
+    if (Supported(isa)) return isa;
+  }
+  return Isa::kScalar;
+}
+
+struct Dispatch {
+  Dispatch() { Select(BestIsa()); }
+
+  void Select(Isa value) {
+    isa.store(value, std::memory_order_relaxed);
+    float_kernels.store(KernelsFor<float>(value), std::memory_order_relaxed);
+    double_kernels.store(KernelsFor<double>(value), std::memory_order_relaxed);
+  }
+
+  std::atomic<Isa> isa;
+  std::atomic<const Kernels<float>*> float_kernels;
+  std::atomic<const Kernels<double>*> double_kernels;
+};
+
+Dispatch& Active() {
+  static Dispatch dispatch;
+  return dispatch;
+}
+
+template <typename T>
+const Kernels<T>& Current();
+
+template <>
+const Kernels<float>& Current<float>() {
+  return *Active().float_kernels.load(std::memory_order_relaxed);
+}
+
+template <>
+const Kernels<double>& Current<double>() {
+  return *Active().double_kernels.load(std::memory_order_relaxed);
+}
+
+// У long double нет векторных инструкций
+template <>
+const Kernels<long double>& Current<long double>() {
+  return kScalarKernels<long double>;
+}
+
+}  // namespace
+
+Isa ActiveIsa() { return Active().isa.load(std::memory_order_relaxed); }
+
+bool SetIsa(Isa isa) {
+  if (!Supported(isa)) return false;
+  Active().Select(isa);
+  return true;
+}
+
+template <typename T>
+void Add(T* a, const T* b, std::size_t count) {
+  Current<T>().add(a, b, count);
+}
+
+template <typename T>
+void Sub(T* a, const T* b, std::size_t count) {
+  Current<T>().sub(a, b, count);
+}
+
+template <typename T>
+void Scale(T* a, T num, std::size_t count) {
+  Current<T>().scale(a, num, count);
+}
+
+template <typename T>
+void Axpy(T* a, T num, const T* b, std::size_t count) {
+  Current<T>().axpy(a, num, b, count);
+}
+
+template <typename T>
+bool EqualWithin(const T* a, const T* b, std::size_t count, T eps) {
+  return Current<T>().equal(a, b, count, eps);
+}
+
+template <typename T>
+void Transpose(const T* src, int rows, int cols, std::ptrdiff_t src_stride,
+               T* dst, std::ptrdiff_t dst_stride) {
+  const Kernels<T>& kernels = Current<T>();
+  for (int ib = 0; ib < rows; ib += kTransposeTile) {
+    const int h = std::min(kTransposeTile, rows - ib);
+    for (int jb = 0; jb < cols; jb += kTransposeTile) {
+      const int w = std::min(kTransposeTile, cols - jb);
+      kernels.transpose_tile(src + ib * src_stride + jb, h, w, src_stride,
+                             dst + jb * dst_stride + ib, dst_stride);
+    }
+  }
+}
+
+template <typename T>
+void TransposeInPlace(T* a, int size, std::ptrdiff_t stride) {
+  const Kernels<T>& kernels = Current<T>();
+  T buffer[kTransposeTile * kTransposeTile];
+  for (int ib = 0; ib < size; ib += kTransposeTile) {
+    const int h = std::min(kTransposeTile, size - ib);
+    // Диагональная плитка: обмен симметричных элементов
+    T* diagonal = a + ib * stride + ib;
+    for (int i = 0; i < h; i++) {
+      for (int j = i + 1; j < h; j++) {
+        std::swap(diagonal[i * stride + j], diagonal[j * stride + i]);
+      }
+    }
+    // Пара плиток (ib, jb) и (jb, ib) меняется местами через буфер
+    for (int jb = ib + kTransposeTile; jb < size; jb += kTransposeTile) {
+      const int w = std::min(kTransposeTile, size - jb);
+      T* upper = a + ib * stride + jb;
+      T* lower = a + jb * stride + ib;
+      kernels.transpose_tile(upper, h, w, stride, buffer, h);
+      kernels.transpose_tile(lower, w, h, stride, upper, stride);
+      for (int i = 0; i < w; i++) {
+        std::copy(buffer + i * h, buffer + (i + 1) * h, lower + i * stride);
+      }
+    }
+  }
+}
+
+#define S21_SIMD_INSTANTIATE(T)                                        \
+  template void Add<T>(T*, const T*, std::size_t);                     \
+  template void Sub<T>(T*, const T*, std::size_t);                     \
+  template void Scale<T>(T*, T, std::size_t);                          \
+  template void Axpy<T>(T*, T, const T*, std::size_t);                 \
+  template bool EqualWithin<T>(const T*, const T*, std::size_t, T);    \
+  template void Transpose<T>(const T*, int, int, std::ptrdiff_t, T*,   \
+                             std::ptrdiff_t);                          \
+  template void TransposeInPlace<T>(T*, int, std::ptrdiff_t);
+
+S21_SIMD_INSTANTIATE(float)
+S21_SIMD_INSTANTIATE(double)
+S21_SIMD_INSTANTIATE(long double)
+
+#undef S21_SIMD_INSTANTIATE
+
+}  // namespace simd
+}  // namespace s21
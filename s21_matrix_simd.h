@@ -0,0 +1,49 @@
+#ifndef MATRIX_SRC_S21_MATRIX_SIMD_H
+#define MATRIX_SRC_S21_MATRIX_SIMD_H
+
+#include <cstddef>
+
+namespace s21 {
+namespace simd {
+
+// Набор инструкций, которым выполняются поэлементные ядра.
+// По умолчанию выбирается лучший из поддерживаемых процессором
+// при первом обращении.
+enum class Isa { kScalar, kSse2, kAvx2, kAvx512 };
+
+Isa ActiveIsa();
+// Принудительный выбор набора; false, если процессор его не поддерживает
+bool SetIsa(Isa isa);
+
+// Ядра определены для float и double (векторные на каждом наборе)
+// и для long double (всегда скалярные).
+
+// a[i] += b[i]
+template <typename T>
+void Add(T* a, const T* b, std::size_t count);
+// a[i] -= b[i]
+template <typename T>
+void Sub(T* a, const T* b, std::size_t count);
+// a[i] *= num
+template <typename T>
+void Scale(T* a, T num, std::size_t count);
+// a[i] += num * b[i] (умножение и сложение раздельно, без FMA,
+// чтобы результат не зависел от набора инструкций)
+template <typename T>
+void Axpy(T* a, T num, const T* b, std::size_t count);
+// Все |a[i] - b[i]| <= eps; выход на первом несовпавшем векторе
+template <typename T>
+bool EqualWithin(const T* a, const T* b, std::size_t count, T eps);
+
+// dst = src^T для src размером rows x cols, плитками по 32 x 32
+template <typename T>
+void Transpose(const T* src, int rows, int cols, std::ptrdiff_t src_stride,
+               T* dst, std::ptrdiff_t dst_stride);
+// Транспонирование квадратной матрицы на месте без выделения памяти
+template <typename T>
+void TransposeInPlace(T* a, int size, std::ptrdiff_t stride);
+
+}  // namespace simd
+}  // namespace s21
+
+#endif  // MATRIX_SRC_S21_MATRIX_SIMD_H
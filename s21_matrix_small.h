@@ -0,0 +1,166 @@
+#ifndef MATRIX_SRC_S21_MATRIX_SMALL_H
+#define MATRIX_SRC_S21_MATRIX_SMALL_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+// Внутренние ядра, общие для S21BasicMatrix, S21FixedMatrix и
+// S21BasicMatrixBatch: явные формулы определителя порядка до 4 и
+// LU-разложение с проверкой вырожденности. Элемент (i, j) матрицы n x n
+// берётся вызовом e(i, j).
+namespace s21 {
+namespace small_matrix {
+
+// Миноры 2x2 верхней (s) и нижней (c) пар строк матрицы 4x4
+template <typename T>
+struct Minors4 {
+  T s0, s1, s2, s3, s4, s5;
+  T c0, c1, c2, c3, c4, c5;
+};
+
+template <typename T, typename E>
+constexpr Minors4<T> Pairs4(const E& e) {
+  return {e(0, 0) * e(1, 1) - e(1, 0) * e(0, 1),
+          e(0, 0) * e(1, 2) - e(1, 0) * e(0, 2),
+          e(0, 0) * e(1, 3) - e(1, 0) * e(0, 3),
+          e(0, 1) * e(1, 2) - e(1, 1) * e(0, 2),
+          e(0, 1) * e(1, 3) - e(1, 1) * e(0, 3),
+          e(0, 2) * e(1, 3) - e(1, 2) * e(0, 3),
+          e(2, 0) * e(3, 1) - e(3, 0) * e(2, 1),
+          e(2, 0) * e(3, 2) - e(3, 0) * e(2, 2),
+          e(2, 0) * e(3, 3) - e(3, 0) * e(2, 3),
+          e(2, 1) * e(3, 2) - e(3, 1) * e(2, 2),
+          e(2, 1) * e(3, 3) - e(3, 1) * e(2, 3),
+          e(2, 2) * e(3, 3) - e(3, 2) * e(2, 3)};
+}
+
+// Определитель порядка N <= 4 разложением по строкам. Для матрицы
+// из целых чисел результат точный, пока произведения представимы в T
+template <typename T, int N, typename E>
+constexpr T ClosedDeterminant(const E& e) {
+  static_assert(N >= 1 && N <= 4, "Closed form is defined for N <= 4");
+  if constexpr (N == 1) {
+    return e(0, 0);
+  } else if constexpr (N == 2) {
+    return e(0, 0) * e(1, 1) - e(0, 1) * e(1, 0);
+  } else if constexpr (N == 3) {
+    return e(0, 0) * (e(1, 1) * e(2, 2) - e(1, 2) * e(2, 1)) -
+           e(0, 1) * (e(1, 0) * e(2, 2) - e(1, 2) * e(2, 0)) +
+           e(0, 2) * (e(1, 0) * e(2, 1) - e(1, 1) * e(2, 0));
+  } else {
+    const Minors4<T> m = Pairs4<T>(e);
+    return m.s0 * m.c5 - m.s1 * m.c4 + m.s2 * m.c3 + m.s3 * m.c2 -
+           m.s4 * m.c1 + m.s5 * m.c0;
+  }
+}
+
+// Определитель порядка n <= 4 без шаблонного параметра
+template <typename T, typename E>
+T ClosedDeterminant(const E& e, int n) {
+  switch (n) {
+    case 1:
+      return ClosedDeterminant<T, 1>(e);
+    case 2:
+      return ClosedDeterminant<T, 2>(e);
+    case 3:
+      return ClosedDeterminant<T, 3>(e);
+    default:
+      return ClosedDeterminant<T, 4>(e);
+  }
+}
+
+// LU-разложение с частичным выбором ведущего элемента на месте:
+// под диагональю остаются множители L (единичная диагональ не хранится),
+// на диагонали и выше — U. В pivots[k] записывается строка, переставленная
+// с k-й на шаге k. Возвращает знак перестановки (1 или -1) или 0, если
+// весь остаток k-го столбца — точные нули и разложение остановлено.
+// Малые, но ненулевые ведущие элементы не отбрасываются: определитель
+// равен знаку, умноженному на произведение диагонали U
+template <typename T>
+int LuDecompose(T* lu, int size, std::size_t stride, int* pivots) {
+  int sign = 1;
+  for (int k = 0; k < size; k++) {
+    int pivot = k;
+    T max = std::fabs(lu[k * stride + k]);
+    for (int i = k + 1; i < size; i++) {
+      const T value = std::fabs(lu[i * stride + k]);
+      if (value > max) {
+        max = value;
+        pivot = i;
+      }
+    }
+    if (pivots) pivots[k] = pivot;
+    if (max == 0) return 0;
+    T* row_k = lu + k * stride;
+    if (pivot != k) {
+      std::swap_ranges(row_k, row_k + size, lu + pivot * stride);
+      sign = -sign;
+    }
+    const T inv_pivot = T(1) / row_k[k];
+    for (int i = k + 1; i < size; i++) {
+      T* row_i = lu + i * stride;
+      const T factor = row_i[k] * inv_pivot;
+      row_i[k] = factor;
+      if (factor != 0) {
+        for (int j = k + 1; j < size; j++) {
+          row_i[j] -= factor * row_k[j];
+        }
+      }
+    }
+  }
+  return sign;
+}
+
+// Масштабы матрицы порядка size: max|a_ij| каждой строки и каждого столбца
+template <typename T, typename E>
+void Scales(const E& e, int size, T* rows, T* cols) {
+  std::fill(rows, rows + size, T(0));
+  std::fill(cols, cols + size, T(0));
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      const T value = std::fabs(e(i, j));
+      rows[i] = std::max(rows[i], value);
+      cols[j] = std::max(cols[j], value);
+    }
+  }
+}
+
+// Признак вырожденности после LuDecompose с ненулевым знаком: ведущий
+// элемент u_kk не превышает size * epsilon(T), умноженного на меньший
+// из масштабов его исходной строки и k-го столбца. Сравнение идёт не
+// с max|a_ij| всей матрицы, поэтому хорошо обусловленная матрица с
+// сильно разными по величине строками или столбцами (diag(1e10, 1e-7))
+// не считается вырожденной. rows переставляется по pivots
+template <typename T>
+bool HasNegligiblePivot(const T* lu, int size, std::size_t stride,
+                        const int* pivots, T* rows, const T* cols) {
+  const T eps = size * std::numeric_limits<T>::epsilon();
+  for (int k = 0; k < size; k++) {
+    std::swap(rows[k], rows[pivots[k]]);
+    const T scale = std::min(rows[k], cols[k]);
+    if (std::fabs(lu[k * stride + k]) <= eps * scale) return true;
+  }
+  return false;
+}
+
+// Признак вырожденности матрицы порядка N тем же правилом, что
+// в S21BasicLU: разложение копии на стеке и HasNegligiblePivot
+template <typename T, int N, typename E>
+bool IsSingular(const E& e) {
+  T lu[N * N], rows[N], cols[N];
+  int pivots[N];
+  for (int i = 0; i < N; i++) {
+    for (int j = 0; j < N; j++) lu[i * N + j] = e(i, j);
+  }
+  Scales<T>(e, N, rows, cols);
+  return LuDecompose(lu, N, N, pivots) == 0 ||
+         HasNegligiblePivot(lu, N, N, pivots, rows, cols);
+}
+
+}  // namespace small_matrix
+}  // namespace s21
+
+#endif  // MATRIX_SRC_S21_MATRIX_SMALL_H
@@ -0,0 +1,357 @@
+#include "s21_matrix_sparse.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "s21_matrix_simd.h"
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Строк результата в одной задаче пула
+constexpr int kRowsPerTask = 64;
+
+// body(first, last) для блоков строк [first, last), параллельно по блокам
+template <typename F>
+void ForEachRowBlock(int rows, const F& body) {
+  const int tasks = (rows + kRowsPerTask - 1) / kRowsPerTask;
+  S21ThreadPool& pool = S21ThreadPool::Global();
+  if (tasks > 1 && pool.Size() > 1) {
+    pool.ParallelFor(tasks, [&](int task) {
+      body(task * kRowsPerTask, std::min(rows, (task + 1) * kRowsPerTask));
+    });
+  } else {
+    body(0, rows);
+  }
+}
+
+}  // namespace
+
+/////////////          Конструкторы        /////////////////
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix()
+    : rows_(0), cols_(0), row_ptr_(1, 0) {}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(int rows, int cols)
+    : rows_(rows), cols_(cols) {
+  if (rows_ <= 0 || cols_ <= 0) {
+    rows_ = 0;
+    cols_ = 0;
+  }
+  row_ptr_.assign(rows_ + 1, 0);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                              T tolerance)
+    : S21BasicSparseMatrix(dense.rows_, dense.cols_) {
+  for (int i = 0; i < rows_; i++) {
+    const T* row = dense.matrix_ + dense.Offset(i, 0);
+    for (int j = 0; j < cols_; j++) {
+      if (std::fabs(row[j]) > tolerance) {
+        col_idx_.push_back(j);
+        values_.push_back(row[j]);
+      }
+    }
+    row_ptr_[i + 1] = static_cast<int>(values_.size());
+  }
+}
+
+template <typename T>
+S21BasicSparseMatrix<T>::S21BasicSparseMatrix(
+    int rows, int cols, const std::vector<Triplet>& triplets)
+    : S21BasicSparseMatrix(rows, cols) {
+  for (const Triplet& t : triplets) {
+    if (t.row < 0 || t.row >= rows_ || t.col < 0 || t.col >= cols_) {
+      throw std::out_of_range("Out of range. Incorrect input");
+    }
+  }
+  // Раскладка по строкам подсчётом, затем сортировка внутри строк
+  std::vector<int> starts(rows_ + 1, 0);
+  for (const Triplet& t : triplets) starts[t.row + 1]++;
+  for (int i = 0; i < rows_; i++) starts[i + 1] += starts[i];
+  std::vector<std::pair<int, T>> entries(triplets.size());
+  std::vector<int> next(starts.begin(), starts.end() - 1);
+  for (const Triplet& t : triplets) {
+    entries[next[t.row]++] = {t.col, t.value};
+  }
+  for (int i = 0; i < rows_; i++) {
+    auto first = entries.begin() + starts[i];
+    auto last = entries.begin() + starts[i + 1];
+    std::sort(first, last, [](const std::pair<int, T>& a,
+                              const std::pair<int, T>& b) {
+      return a.first < b.first;
+    });
+    for (auto it = first; it != last;) {
+      const int col = it->first;
+      T sum = 0;
+      for (; it != last && it->first == col; ++it) sum += it->second;
+      if (sum != 0) {
+        col_idx_.push_back(col);
+        values_.push_back(sum);
+      }
+    }
+    row_ptr_[i + 1] = static_cast<int>(values_.size());
+  }
+}
+
+/////////////          Доступ к элементам        /////////////////
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetRows() const { return rows_; }
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetCols() const { return cols_; }
+
+template <typename T>
+int S21BasicSparseMatrix<T>::GetNonZeros() const {
+  return static_cast<int>(values_.size());
+}
+
+template <typename T>
+T S21BasicSparseMatrix<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  const auto first = col_idx_.begin() + row_ptr_[i];
+  const auto last = col_idx_.begin() + row_ptr_[i + 1];
+  const auto it = std::lower_bound(first, last, j);
+  return it != last && *it == j ? values_[it - col_idx_.begin()] : T(0);
+}
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::ToDense() const {
+  S21BasicMatrix<T> result(rows_, cols_);
+  for (int i = 0; i < rows_; i++) {
+    T* row = result.matrix_ + result.Offset(i, 0);
+    for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; p++) {
+      row[col_idx_[p]] = values_[p];
+    }
+  }
+  return result;
+}
+
+template <typename T>
+const std::vector<int>& S21BasicSparseMatrix<T>::RowPointers() const {
+  return row_ptr_;
+}
+
+template <typename T>
+const std::vector<int>& S21BasicSparseMatrix<T>::ColIndices() const {
+  return col_idx_;
+}
+
+template <typename T>
+const std::vector<T>& S21BasicSparseMatrix<T>::Values() const {
+  return values_;
+}
+
+/////////////          Поэлементные операции        /////////////////
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SumMatrix(const S21BasicSparseMatrix& other) {
+  Merge(other, T(1));
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::SubMatrix(const S21BasicSparseMatrix& other) {
+  Merge(other, T(-1));
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MulNumber(const T num) {
+  if (num == 0) {
+    std::fill(row_ptr_.begin(), row_ptr_.end(), 0);
+    col_idx_.clear();
+    values_.clear();
+    return;
+  }
+  s21::simd::Scale(values_.data(), num, values_.size());
+}
+
+// Слияние упорядоченных строк двух матриц
+template <typename T>
+void S21BasicSparseMatrix<T>::Merge(const S21BasicSparseMatrix& other,
+                                    T sign) {
+  if (rows_ != other.rows_ || cols_ != other.cols_) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  std::vector<int> row_ptr(rows_ + 1, 0);
+  std::vector<int> col_idx;
+  std::vector<T> values;
+  col_idx.reserve(values_.size() + other.values_.size());
+  values.reserve(values_.size() + other.values_.size());
+  auto emit = [&](int col, T value) {
+    if (value != 0) {
+      col_idx.push_back(col);
+      values.push_back(value);
+    }
+  };
+  for (int i = 0; i < rows_; i++) {
+    int p = row_ptr_[i], q = other.row_ptr_[i];
+    const int p_end = row_ptr_[i + 1], q_end = other.row_ptr_[i + 1];
+    while (p < p_end || q < q_end) {
+      if (q == q_end || (p < p_end && col_idx_[p] < other.col_idx_[q])) {
+        emit(col_idx_[p], values_[p]);
+        p++;
+      } else if (p == p_end || other.col_idx_[q] < col_idx_[p]) {
+        emit(other.col_idx_[q], sign * other.values_[q]);
+        q++;
+      } else {
+        emit(col_idx_[p], values_[p] + sign * other.values_[q]);
+        p++;
+        q++;
+      }
+    }
+    row_ptr[i + 1] = static_cast<int>(values.size());
+  }
+  row_ptr_ = std::move(row_ptr);
+  col_idx_ = std::move(col_idx);
+  values_ = std::move(values);
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::Transpose() const {
+  S21BasicSparseMatrix result(cols_, rows_);
+  for (int col : col_idx_) result.row_ptr_[col + 1]++;
+  for (int j = 0; j < cols_; j++) {
+    result.row_ptr_[j + 1] += result.row_ptr_[j];
+  }
+  result.col_idx_.resize(values_.size());
+  result.values_.resize(values_.size());
+  std::vector<int> next(result.row_ptr_.begin(), result.row_ptr_.end() - 1);
+  // Строки обходятся по порядку, поэтому столбцы результата упорядочены
+  for (int i = 0; i < rows_; i++) {
+    for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; p++) {
+      const int dst = next[col_idx_[p]]++;
+      result.col_idx_[dst] = i;
+      result.values_[dst] = values_[p];
+    }
+  }
+  return result;
+}
+
+/////////////          Умножение        /////////////////
+
+template <typename T>
+S21BasicMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicMatrix<T>& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
+  }
+  S21BasicMatrix<T> result(rows_, other.cols_);
+  const int n = other.cols_;
+  ForEachRowBlock(rows_, [&](int first, int last) {
+    for (int i = first; i < last; i++) {
+      T* c = result.matrix_ + result.Offset(i, 0);
+      for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; p++) {
+        s21::simd::Axpy(c, values_[p],
+                        other.matrix_ + other.Offset(col_idx_[p], 0), n);
+      }
+    }
+  });
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const S21BasicSparseMatrix& other) const {
+  if (cols_ != other.rows_) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
+  }
+  S21BasicSparseMatrix result(rows_, other.cols_);
+  if (result.rows_ == 0) return result;
+  // Каждый блок строк собирает свои элементы отдельно, затем блоки
+  // копируются на места по префиксным суммам числа элементов строк
+  const int tasks = (rows_ + kRowsPerTask - 1) / kRowsPerTask;
+  std::vector<std::vector<int>> block_cols(tasks);
+  std::vector<std::vector<T>> block_values(tasks);
+  ForEachRowBlock(rows_, [&](int first, int last) {
+    const int task = first / kRowsPerTask;
+    std::vector<int>& cols = block_cols[task];
+    std::vector<T>& values = block_values[task];
+    // Плотный накопитель строки и отметка «столбец уже в строке i»
+    std::vector<T> acc(other.cols_);
+    std::vector<int> mark(other.cols_, -1);
+    std::vector<int> touched;
+    for (int i = first; i < last; i++) {
+      touched.clear();
+      for (int p = row_ptr_[i]; p < row_ptr_[i + 1]; p++) {
+        const int k = col_idx_[p];
+        const T a = values_[p];
+        for (int q = other.row_ptr_[k]; q < other.row_ptr_[k + 1]; q++) {
+          const int j = other.col_idx_[q];
+          if (mark[j] != i) {
+            mark[j] = i;
+            acc[j] = a * other.values_[q];
+            touched.push_back(j);
+          } else {
+            acc[j] += a * other.values_[q];
+          }
+        }
+      }
+      std::sort(touched.begin(), touched.end());
+      int count = 0;
+      for (int j : touched) {
+        if (acc[j] != 0) {
+          cols.push_back(j);
+          values.push_back(acc[j]);
+          count++;
+        }
+      }
+      result.row_ptr_[i + 1] = count;
+    }
+  });
+  for (int i = 0; i < rows_; i++) {
+    result.row_ptr_[i + 1] += result.row_ptr_[i];
+  }
+  result.col_idx_.resize(result.row_ptr_[rows_]);
+  result.values_.resize(result.row_ptr_[rows_]);
+  for (int task = 0; task < tasks; task++) {
+    const int offset = result.row_ptr_[task * kRowsPerTask];
+    std::copy(block_cols[task].begin(), block_cols[task].end(),
+              result.col_idx_.begin() + offset);
+    std::copy(block_values[task].begin(), block_values[task].end(),
+              result.values_.begin() + offset);
+  }
+  return result;
+}
+
+template <typename T>
+void S21BasicSparseMatrix<T>::MulMatrix(const S21BasicSparseMatrix& other) {
+  *this = *this * other;
+}
+
+/////////////          Операторы        /////////////////
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator+(
+    const S21BasicSparseMatrix& other) const {
+  S21BasicSparseMatrix result(*this);
+  result.SumMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator-(
+    const S21BasicSparseMatrix& other) const {
+  S21BasicSparseMatrix result(*this);
+  result.SubMatrix(other);
+  return result;
+}
+
+template <typename T>
+S21BasicSparseMatrix<T> S21BasicSparseMatrix<T>::operator*(
+    const T num) const {
+  S21BasicSparseMatrix result(*this);
+  result.MulNumber(num);
+  return result;
+}
+
+template class S21BasicSparseMatrix<float>;
+template class S21BasicSparseMatrix<double>;
+template class S21BasicSparseMatrix<long double>;
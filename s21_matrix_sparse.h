@@ -0,0 +1,73 @@
+#ifndef MATRIX_SRC_S21_MATRIX_SPARSE_H
+#define MATRIX_SRC_S21_MATRIX_SPARSE_H
+
+#include <vector>
+
+#include "s21_matrix_oop.h"
+
+// Разреженная матрица в формате CSR: ненулевые элементы строки i лежат
+// в values_[row_ptr_[i] ... row_ptr_[i + 1]) по возрастанию столбцов
+// col_idx_. Память и время операций пропорциональны числу ненулевых
+// элементов, а не rows x cols.
+// CSR-представление транспонированной матрицы — это CSC исходной,
+// поэтому отдельного типа для CSC нет: Transpose() переводит одно
+// в другое подсчётом за O(nnz + cols).
+// Умножения делят строки результата между потоками S21ThreadPool::Global().
+template <typename T>
+class S21BasicSparseMatrix {
+ public:
+  // Элемент (row, col) со значением value для построения по списку
+  struct Triplet {
+    int row, col;
+    T value;
+  };
+
+  S21BasicSparseMatrix();
+  // Нулевая матрица rows x cols
+  S21BasicSparseMatrix(int rows, int cols);
+  // Элементы dense, по модулю большие tolerance
+  explicit S21BasicSparseMatrix(const S21BasicMatrix<T>& dense,
+                                T tolerance = 0);
+  // Тройки в любом порядке; значения с одинаковыми (row, col) складываются
+  S21BasicSparseMatrix(int rows, int cols,
+                       const std::vector<Triplet>& triplets);
+
+  int GetRows() const;
+  int GetCols() const;
+  int GetNonZeros() const;
+  T operator()(int i, int j) const;
+  S21BasicMatrix<T> ToDense() const;
+
+  // Массивы CSR для передачи в другие библиотеки
+  const std::vector<int>& RowPointers() const;
+  const std::vector<int>& ColIndices() const;
+  const std::vector<T>& Values() const;
+
+  // Поэлементные операции; взаимно уничтожившиеся элементы удаляются
+  void SumMatrix(const S21BasicSparseMatrix& other);
+  void SubMatrix(const S21BasicSparseMatrix& other);
+  void MulNumber(const T num);
+  void MulMatrix(const S21BasicSparseMatrix& other);
+  S21BasicSparseMatrix Transpose() const;
+
+  // Разреженная на плотную: строка результата накапливается из строк
+  // other векторным ядром s21::simd::Axpy
+  S21BasicMatrix<T> operator*(const S21BasicMatrix<T>& other) const;
+  // Разреженная на разреженную (алгоритм Густавсона)
+  S21BasicSparseMatrix operator*(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix operator+(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix operator-(const S21BasicSparseMatrix& other) const;
+  S21BasicSparseMatrix operator*(const T num) const;
+
+ private:
+  void Merge(const S21BasicSparseMatrix& other, T sign);
+
+  int rows_, cols_;
+  std::vector<int> row_ptr_;
+  std::vector<int> col_idx_;
+  std::vector<T> values_;
+};
+
+using S21SparseMatrix = S21BasicSparseMatrix<double>;
+
+#endif  // MATRIX_SRC_S21_MATRIX_SPARSE_H
@@ -0,0 +1,220 @@
+#include "s21_matrix_stats.h"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+using s21::stats::kOpCount;
+using s21::stats::Op;
+using s21::stats::Snapshot;
+
+// Счётчики одного потока. Пишет только поток-владелец (load + store без
+// read-modify-write), читать их может любой поток
+struct Counters {
+  std::atomic<std::uint64_t> calls[kOpCount] = {};
+  std::atomic<std::uint64_t> nanoseconds[kOpCount] = {};
+  std::atomic<std::uint64_t> flops[kOpCount] = {};
+  std::atomic<std::uint64_t> allocations{0};
+  std::atomic<std::uint64_t> bytes_allocated{0};
+};
+
+void Bump(std::atomic<std::uint64_t>& counter, std::uint64_t value) {
+  counter.store(counter.load(std::memory_order_relaxed) + value,
+                std::memory_order_relaxed);
+}
+
+void AddTo(Snapshot& total, const Counters& counters) {
+  for (int k = 0; k < kOpCount; k++) {
+    total.ops[k].calls += counters.calls[k].load(std::memory_order_relaxed);
+    total.ops[k].nanoseconds +=
+        counters.nanoseconds[k].load(std::memory_order_relaxed);
+    total.ops[k].flops += counters.flops[k].load(std::memory_order_relaxed);
+  }
+  total.allocations += counters.allocations.load(std::memory_order_relaxed);
+  total.bytes_allocated +=
+      counters.bytes_allocated.load(std::memory_order_relaxed);
+}
+
+void Clear(Counters& counters) {
+  for (int k = 0; k < kOpCount; k++) {
+    counters.calls[k].store(0, std::memory_order_relaxed);
+    counters.nanoseconds[k].store(0, std::memory_order_relaxed);
+    counters.flops[k].store(0, std::memory_order_relaxed);
+  }
+  counters.allocations.store(0, std::memory_order_relaxed);
+  counters.bytes_allocated.store(0, std::memory_order_relaxed);
+}
+
+void DumpAtExit();
+
+// Блоки живых потоков и сумма по завершившимся
+class Registry {
+ public:
+  static Registry& Instance() {
+    // Не разрушается: снимок пишется из atexit после статических объектов
+    static Registry* instance = new Registry;
+    return *instance;
+  }
+
+  void Attach(Counters* counters) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    live_.push_back(counters);
+  }
+
+  void Detach(Counters* counters) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    AddTo(retired_, *counters);
+    for (std::size_t k = 0; k < live_.size(); k++) {
+      if (live_[k] == counters) {
+        live_[k] = live_.back();
+        live_.pop_back();
+        break;
+      }
+    }
+  }
+
+  // Для потоков, чей блок уже разрушен
+  void AddRetired(Op op, std::uint64_t nanoseconds, std::uint64_t flops) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    s21::stats::OpStats& stats = retired_.ops[static_cast<int>(op)];
+    stats.calls++;
+    stats.nanoseconds += nanoseconds;
+    stats.flops += flops;
+  }
+
+  void AddRetiredAllocation(std::size_t bytes) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_.allocations++;
+    retired_.bytes_allocated += bytes;
+  }
+
+  Snapshot Collect() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Snapshot total = retired_;
+    for (const Counters* counters : live_) AddTo(total, *counters);
+    return total;
+  }
+
+  void Reset() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    retired_ = Snapshot();
+    for (Counters* counters : live_) Clear(*counters);
+  }
+
+ private:
+  Registry() {
+    if (std::getenv("S21_MATRIX_STATS")) std::atexit(DumpAtExit);
+  }
+
+  std::mutex mutex_;
+  std::vector<Counters*> live_;
+  Snapshot retired_;
+};
+
+thread_local bool tls_counters_destroyed = false;
+
+class ThreadCounters {
+ public:
+  ThreadCounters() { Registry::Instance().Attach(&counters_); }
+  ~ThreadCounters() {
+    Registry::Instance().Detach(&counters_);
+    tls_counters_destroyed = true;
+  }
+
+  Counters& Get() { return counters_; }
+
+ private:
+  Counters counters_;
+};
+
+thread_local ThreadCounters tls_counters;
+
+void DumpAtExit() {
+  const char* path = std::getenv("S21_MATRIX_STATS");
+  if (!path) return;
+  const bool to_stderr = path[0] == '-' && path[1] == '\0';
+  std::FILE* out = to_stderr ? stderr : std::fopen(path, "w");
+  if (!out) return;
+  const std::string json = s21::stats::ToJson(s21::stats::Collect());
+  std::fputs(json.c_str(), out);
+  std::fputc('\n', out);
+  if (!to_stderr) std::fclose(out);
+}
+
+}  // namespace
+
+namespace s21 {
+namespace stats {
+
+const char* Name(Op op) {
+  switch (op) {
+    case Op::kSumMatrix:
+      return "SumMatrix";
+    case Op::kSubMatrix:
+      return "SubMatrix";
+    case Op::kMulNumber:
+      return "MulNumber";
+    case Op::kMulMatrix:
+      return "MulMatrix";
+    case Op::kTranspose:
+      return "Transpose";
+    case Op::kCalcComplements:
+      return "CalcComplements";
+    case Op::kDeterminant:
+      return "Determinant";
+    case Op::kInverseMatrix:
+      return "InverseMatrix";
+    default:
+      return "Unknown";
+  }
+}
+
+Snapshot Collect() { return Registry::Instance().Collect(); }
+
+void Reset() { Registry::Instance().Reset(); }
+
+std::string ToJson(const Snapshot& snapshot) {
+  std::string json = "{\"operations\": {";
+  for (int k = 0; k < kOpCount; k++) {
+    const OpStats& stats = snapshot.ops[k];
+    if (k > 0) json += ", ";
+    json += "\"";
+    json += Name(static_cast<Op>(k));
+    json += "\": {\"calls\": " + std::to_string(stats.calls) +
+            ", \"nanoseconds\": " + std::to_string(stats.nanoseconds) +
+            ", \"flops\": " + std::to_string(stats.flops) + "}";
+  }
+  json += "}, \"allocations\": " + std::to_string(snapshot.allocations) +
+          ", \"bytes_allocated\": " +
+          std::to_string(snapshot.bytes_allocated) + "}";
+  return json;
+}
+
+void AddOp(Op op, std::uint64_t nanoseconds, std::uint64_t flops) {
+  if (tls_counters_destroyed) {
+    Registry::Instance().AddRetired(op, nanoseconds, flops);
+    return;
+  }
+  Counters& counters = tls_counters.Get();
+  const int k = static_cast<int>(op);
+  Bump(counters.calls[k], 1);
+  Bump(counters.nanoseconds[k], nanoseconds);
+  Bump(counters.flops[k], flops);
+}
+
+void AddAllocation(std::size_t bytes) {
+  if (tls_counters_destroyed) {
+    Registry::Instance().AddRetiredAllocation(bytes);
+    return;
+  }
+  Counters& counters = tls_counters.Get();
+  Bump(counters.allocations, 1);
+  Bump(counters.bytes_allocated, bytes);
+}
+
+}  // namespace stats
+}  // namespace s21
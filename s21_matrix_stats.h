@@ -0,0 +1,110 @@
+#ifndef MATRIX_SRC_S21_MATRIX_STATS_H
+#define MATRIX_SRC_S21_MATRIX_STATS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Счётчики горячих операций библиотеки: число вызовов, суммарное время,
+// число операций с плавающей точкой и выделенная под матрицы память.
+// Собираются только при сборке библиотеки с -DS21_MATRIX_INSTRUMENT
+// (make ... INSTRUMENT=1); без флага макросы S21_MATRIX_OP и
+// S21_MATRIX_ALLOC раскрываются в пустое выражение и ничего не стоят,
+// а Collect() возвращает нули.
+//
+// Каждый поток пишет в собственный блок счётчиков без блокировок,
+// Collect() суммирует блоки живых и уже завершившихся потоков.
+// Операции не вкладываются друг в друга: CalcComplements и
+// InverseMatrix раскладывают матрицу через S21BasicLU напрямую, поэтому
+// вызов Determinant в их счётчики не попадает и учитывается только
+// при явном вызове.
+// Если задана переменная окружения S21_MATRIX_STATS, при выходе из
+// программы снимок записывается в этот файл в формате JSON
+// (значение "-" — в stderr).
+namespace s21 {
+namespace stats {
+
+#ifdef S21_MATRIX_INSTRUMENT
+constexpr bool kEnabled = true;
+#else
+constexpr bool kEnabled = false;
+#endif
+
+enum class Op {
+  kSumMatrix,
+  kSubMatrix,
+  kMulNumber,
+  kMulMatrix,
+  kTranspose,
+  kCalcComplements,
+  kDeterminant,
+  kInverseMatrix,
+  kCount
+};
+
+constexpr int kOpCount = static_cast<int>(Op::kCount);
+
+const char* Name(Op op);
+
+struct OpStats {
+  std::uint64_t calls = 0;
+  std::uint64_t nanoseconds = 0;
+  std::uint64_t flops = 0;
+};
+
+struct Snapshot {
+  OpStats ops[kOpCount];
+  std::uint64_t allocations = 0;
+  std::uint64_t bytes_allocated = 0;
+
+  const OpStats& operator[](Op op) const {
+    return ops[static_cast<int>(op)];
+  }
+};
+
+Snapshot Collect();
+// Обнуляет счётчики всех потоков; вызывать, пока другие потоки
+// не выполняют операций
+void Reset();
+std::string ToJson(const Snapshot& snapshot);
+
+void AddOp(Op op, std::uint64_t nanoseconds, std::uint64_t flops);
+void AddAllocation(std::size_t bytes);
+
+// Замер операции от создания до конца области видимости
+class ScopedOp {
+ public:
+  ScopedOp(Op op, double flops)
+      : op_(op),
+        flops_(static_cast<std::uint64_t>(flops)),
+        start_(std::chrono::steady_clock::now()) {}
+  ScopedOp(const ScopedOp&) = delete;
+  ScopedOp& operator=(const ScopedOp&) = delete;
+  ~ScopedOp() {
+    const auto elapsed = std::chrono::steady_clock::now() - start_;
+    AddOp(op_,
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+              .count(),
+          flops_);
+  }
+
+ private:
+  Op op_;
+  std::uint64_t flops_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+}  // namespace stats
+}  // namespace s21
+
+#ifdef S21_MATRIX_INSTRUMENT
+#define S21_MATRIX_OP(op, flops) \
+  ::s21::stats::ScopedOp s21_stats_op_(::s21::stats::Op::op, (flops))
+#define S21_MATRIX_ALLOC(bytes) ::s21::stats::AddAllocation(bytes)
+#else
+#define S21_MATRIX_OP(op, flops) ((void)0)
+#define S21_MATRIX_ALLOC(bytes) ((void)0)
+#endif
+
+#endif  // MATRIX_SRC_S21_MATRIX_STATS_H
@@ -0,0 +1,253 @@
+#include "s21_matrix_stream.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_io.h"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+// Кратность стороны плитки для панелей Gemm
+constexpr int kTileQuantum = 64;
+
+class Descriptor {
+ public:
+  Descriptor(const std::string& path, int flags)
+      : fd_(::open(path.c_str(), flags)) {
+    if (fd_ < 0) throw std::runtime_error("Cannot open file " + path);
+  }
+  Descriptor(const Descriptor&) = delete;
+  Descriptor& operator=(const Descriptor&) = delete;
+  ~Descriptor() { ::close(fd_); }
+
+  int Get() const { return fd_; }
+
+ private:
+  int fd_;
+};
+
+void ReadAt(int fd, void* data, std::size_t bytes, std::size_t offset) {
+  char* dst = static_cast<char*>(data);
+  while (bytes > 0) {
+    const ssize_t done = ::pread(fd, dst, bytes, static_cast<off_t>(offset));
+    if (done <= 0) throw std::runtime_error("Cannot read file");
+    dst += done;
+    offset += done;
+    bytes -= done;
+  }
+}
+
+void WriteAt(int fd, const void* data, std::size_t bytes,
+             std::size_t offset) {
+  const char* src = static_cast<const char*>(data);
+  while (bytes > 0) {
+    const ssize_t done = ::pwrite(fd, src, bytes, static_cast<off_t>(offset));
+    if (done <= 0) throw std::runtime_error("Cannot write file");
+    src += done;
+    offset += done;
+    bytes -= done;
+  }
+}
+
+// Плитка rows x cols с углом (row, col); строки плитки в tile подряд.
+// Плитка во всю ширину файла читается одним запросом
+template <typename T>
+void ReadTile(int fd, const s21::io::FileInfo& info, int row, int col,
+              int rows, int cols, T* tile) {
+  const std::size_t offset =
+      info.data_offset +
+      (static_cast<std::size_t>(row) * info.cols + col) * sizeof(T);
+  if (cols == info.cols) {
+    ReadAt(fd, tile, static_cast<std::size_t>(rows) * cols * sizeof(T),
+           offset);
+    return;
+  }
+  for (int i = 0; i < rows; i++) {
+    ReadAt(fd, tile + static_cast<std::size_t>(i) * cols, cols * sizeof(T),
+           offset + static_cast<std::size_t>(i) * info.cols * sizeof(T));
+  }
+}
+
+template <typename T>
+void WriteTile(int fd, const s21::io::FileInfo& info, int row, int col,
+               int rows, int cols, const T* tile) {
+  const std::size_t offset =
+      info.data_offset +
+      (static_cast<std::size_t>(row) * info.cols + col) * sizeof(T);
+  if (cols == info.cols) {
+    WriteAt(fd, tile, static_cast<std::size_t>(rows) * cols * sizeof(T),
+            offset);
+    return;
+  }
+  for (int i = 0; i < rows; i++) {
+    WriteAt(fd, tile + static_cast<std::size_t>(i) * cols, cols * sizeof(T),
+            offset + static_cast<std::size_t>(i) * info.cols * sizeof(T));
+  }
+}
+
+// Сторона квадратной плитки: две пары плиток A и B и плитка C,
+// 5 * tile^2 элементов, помещаются в бюджет
+template <typename T>
+int TileFor(std::size_t memory_budget, int largest) {
+  const double elements = static_cast<double>(memory_budget) / sizeof(T);
+  int tile = static_cast<int>(std::sqrt(elements / 5));
+  if (tile >= kTileQuantum) tile = tile / kTileQuantum * kTileQuantum;
+  return std::max(1, std::min(tile, largest));
+}
+
+double Seconds(Clock::duration duration) {
+  return std::chrono::duration<double>(duration).count();
+}
+
+// Временный файл результата: удаляется, если не был переименован
+class TemporaryFile {
+ public:
+  explicit TemporaryFile(const std::string& path) : path_(path) {}
+  TemporaryFile(const TemporaryFile&) = delete;
+  TemporaryFile& operator=(const TemporaryFile&) = delete;
+  ~TemporaryFile() {
+    if (!path_.empty()) std::remove(path_.c_str());
+  }
+
+  const std::string& Get() const { return path_; }
+
+  void RenameTo(const std::string& path) {
+    if (std::rename(path_.c_str(), path.c_str()) != 0) {
+      throw std::runtime_error("Cannot write file " + path);
+    }
+    path_.clear();
+  }
+
+ private:
+  std::string path_;
+};
+
+}  // namespace
+
+namespace s21 {
+namespace io {
+
+template <typename T>
+StreamStats MulMatrixFiles(const std::string& a_path,
+                           const std::string& b_path,
+                           const std::string& c_path,
+                           const StreamOptions& options) {
+  const Clock::time_point start = Clock::now();
+  const DType dtype = DTypeOf<T>::kValue;
+  const FileInfo a = ReadInfo(a_path, dtype, sizeof(T));
+  const FileInfo b = ReadInfo(b_path, dtype, sizeof(T));
+  if (a.cols != b.rows) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
+  }
+  // C пишется рядом и заменяет c_path только в конце: входной файл,
+  // совпадающий с c_path, читается целиком до замены
+  TemporaryFile output(c_path + ".tmp");
+  const FileInfo c = Create(output.Get(), dtype, sizeof(T), a.rows, b.cols);
+  StreamStats stats;
+  if (a.rows == 0 || b.cols == 0) {
+    output.RenameTo(c_path);
+    return stats;
+  }
+
+  const int m = a.rows, n = b.cols, k = a.cols;
+  const int tile =
+      TileFor<T>(options.memory_budget, std::max(m, std::max(n, k)));
+  stats.tile = tile;
+  const int row_tiles = (m + tile - 1) / tile;
+  const int col_tiles = (n + tile - 1) / tile;
+  const int inner_tiles = (k + tile - 1) / tile;
+  const std::int64_t total =
+      static_cast<std::int64_t>(row_tiles) * col_tiles * inner_tiles;
+
+  // Шаг step: плитка C (ib, jb) и панель kb внутреннего размера
+  struct Step {
+    int ib, jb, kb, rows, cols, inner;
+  };
+  auto step_at = [&](std::int64_t step) {
+    const std::int64_t c_tile = step / inner_tiles;
+    Step s;
+    s.ib = static_cast<int>(c_tile / col_tiles) * tile;
+    s.jb = static_cast<int>(c_tile % col_tiles) * tile;
+    s.kb = static_cast<int>(step % inner_tiles) * tile;
+    s.rows = std::min(tile, m - s.ib);
+    s.cols = std::min(tile, n - s.jb);
+    s.inner = std::min(tile, k - s.kb);
+    return s;
+  };
+
+  const Descriptor a_file(a_path, O_RDONLY);
+  const Descriptor b_file(b_path, O_RDONLY);
+  const Descriptor c_file(output.Get(), O_WRONLY);
+  const std::size_t tile_size = static_cast<std::size_t>(tile) * tile;
+  std::vector<T> a_tiles[2] = {std::vector<T>(tile_size),
+                               std::vector<T>(tile_size)};
+  std::vector<T> b_tiles[2] = {std::vector<T>(tile_size),
+                               std::vector<T>(tile_size)};
+  std::vector<T> c_tile(tile_size);
+
+  auto load = [&](std::int64_t step) {
+    const Step s = step_at(step);
+    const int slot = static_cast<int>(step % 2);
+    ReadTile(a_file.Get(), a, s.ib, s.kb, s.rows, s.inner,
+             a_tiles[slot].data());
+    ReadTile(b_file.Get(), b, s.kb, s.jb, s.inner, s.cols,
+             b_tiles[slot].data());
+  };
+
+  std::future<void> pending = std::async(std::launch::async, load, 0);
+  for (std::int64_t step = 0; step < total; step++) {
+    const Clock::time_point wait = Clock::now();
+    pending.get();
+    stats.io_wait_seconds += Seconds(Clock::now() - wait);
+    if (step + 1 < total) {
+      pending = std::async(std::launch::async, load, step + 1);
+    }
+
+    const Step s = step_at(step);
+    const int slot = static_cast<int>(step % 2);
+    if (s.kb == 0) {
+      std::fill(c_tile.begin(), c_tile.begin() + s.rows * s.cols, T(0));
+    }
+    s21::Gemm(s.rows, s.cols, s.inner, a_tiles[slot].data(), s.inner, 1,
+              b_tiles[slot].data(), s.cols, 1, c_tile.data(), s.cols);
+    stats.bytes_read +=
+        static_cast<std::uint64_t>(s.rows + s.cols) * s.inner * sizeof(T);
+    if (s.kb + s.inner == k) {
+      WriteTile(c_file.Get(), c, s.ib, s.jb, s.rows, s.cols, c_tile.data());
+      stats.bytes_written +=
+          static_cast<std::uint64_t>(s.rows) * s.cols * sizeof(T);
+    }
+    if (options.progress) options.progress(step + 1, total);
+  }
+  output.RenameTo(c_path);
+  stats.seconds = Seconds(Clock::now() - start);
+  return stats;
+}
+
+template StreamStats MulMatrixFiles<float>(const std::string&,
+                                           const std::string&,
+                                           const std::string&,
+                                           const StreamOptions&);
+template StreamStats MulMatrixFiles<double>(const std::string&,
+                                            const std::string&,
+                                            const std::string&,
+                                            const StreamOptions&);
+template StreamStats MulMatrixFiles<long double>(const std::string&,
+                                                 const std::string&,
+                                                 const std::string&,
+                                                 const StreamOptions&);
+
+}  // namespace io
+}  // namespace s21
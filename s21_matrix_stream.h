@@ -0,0 +1,48 @@
+#ifndef MATRIX_SRC_S21_MATRIX_STREAM_H
+#define MATRIX_SRC_S21_MATRIX_STREAM_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+// Умножение матриц, не помещающихся в память, по файлам формата
+// s21_matrix_io.h. C делится на плитки, каждая накапливается по
+// панелям внутреннего размера: пара плиток A и B читается с диска
+// в фоновом потоке, пока s21::Gemm умножает предыдущую пару
+// (двойная буферизация), а готовая плитка C сразу дописывается в файл.
+// Память под плитки не превышает memory_budget.
+namespace s21 {
+namespace io {
+
+struct StreamOptions {
+  // Предел памяти под плитки A, B (по две) и C, байт
+  std::size_t memory_budget = std::size_t(256) << 20;
+  // Вызывается после каждого шага: выполнено done шагов из total
+  std::function<void(std::int64_t done, std::int64_t total)> progress;
+};
+
+struct StreamStats {
+  std::uint64_t bytes_read = 0;
+  std::uint64_t bytes_written = 0;
+  // Время, когда вычисления ждали чтения, и общее время
+  double io_wait_seconds = 0;
+  double seconds = 0;
+  // Сторона квадратной плитки
+  int tile = 0;
+};
+
+// c_path = a_path * b_path. C пишется во временный файл c_path + ".tmp"
+// и переименовывается в c_path после последнего шага, поэтому c_path
+// может совпадать с a_path или b_path, а при ошибке прежний файл C
+// остаётся нетронутым. Определено для float, double и long double
+template <typename T>
+StreamStats MulMatrixFiles(const std::string& a_path,
+                           const std::string& b_path,
+                           const std::string& c_path,
+                           const StreamOptions& options = StreamOptions());
+
+}  // namespace io
+}  // namespace s21
+
+#endif  // MATRIX_SRC_S21_MATRIX_STREAM_H
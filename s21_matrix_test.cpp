@@ -1,5 +1,41 @@
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
 #include "gtest/gtest.h"
+#include "s21_fixed_matrix.h"
+#include "s21_matrix_batch.h"
 #include "s21_matrix_oop.h"
+#include "s21_matrix_simd.h"
+#include "s21_matrix_sparse.h"
+#include "s21_matrix_stats.h"
+#include "s21_matrix_stream.h"
+
+// Счётчик выровненных выделений памяти: через них S21Matrix
+// получает блок под элементы
+static std::atomic<long> aligned_allocations{0};
+
+void* operator new(std::size_t size, std::align_val_t align) {
+  aligned_allocations++;
+  const std::size_t alignment = static_cast<std::size_t>(align);
+  void* block =
+      std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+  if (!block) throw std::bad_alloc();
+  return block;
+}
+
+void operator delete(void* block, std::align_val_t) noexcept {
+  std::free(block);
+}
+
+void operator delete(void* block, std::size_t, std::align_val_t) noexcept {
+  std::free(block);
+}
 
 TEST(test, EqMatrix_1) {
   S21Matrix first, second;
@@ -615,6 +651,1161 @@ TEST(valgr, gg) {
   func_inverse = given.InverseMatrix();
 }
 
+TEST(storage, assign_and_resize) {
+  S21Matrix m(3, 4), other(4, 3);
+  for (int i = 0, c = 1; i < 3; i++)
+    for (int j = 0; j < 4; j++, c++) m(i, j) = c;
+
+  other = m;
+  EXPECT_EQ(other.GetRows(), 3);
+  EXPECT_EQ(other.GetCols(), 4);
+  EXPECT_TRUE(other == m);
+
+  m.SetCols(2);
+  m.SetRows(4);
+  for (int i = 0; i < 3; i++) {
+    EXPECT_DOUBLE_EQ(m(i, 0), 4 * i + 1);
+    EXPECT_DOUBLE_EQ(m(i, 1), 4 * i + 2);
+  }
+  EXPECT_DOUBLE_EQ(m(3, 0), 0);
+  EXPECT_DOUBLE_EQ(m(3, 1), 0);
+}
+
+TEST(gemm, blocked_matches_reference) {
+  const int m = 70, k = 300, n = 45;
+  S21Matrix a(m, k), b(k, n);
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < k; j++) a(i, j) = (i * 7 + j * 3) % 11 - 5;
+  for (int i = 0; i < k; i++)
+    for (int j = 0; j < n; j++) b(i, j) = (i * 5 + j * 2) % 13 - 6;
+
+  S21Matrix c = a * b;
+  ASSERT_EQ(c.GetRows(), m);
+  ASSERT_EQ(c.GetCols(), n);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      double sum = 0;
+      for (int p = 0; p < k; p++) sum += a(i, p) * b(p, j);
+      EXPECT_DOUBLE_EQ(c(i, j), sum);
+    }
+  }
+}
+
+TEST(gemm, thread_count_is_deterministic) {
+  const int n = 300;
+  S21Matrix a(n, n), b(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a(i, j) = std::sin(i * 0.37 + j * 0.11);
+      b(i, j) = std::cos(i * 0.05 - j * 0.29);
+    }
+  }
+  const int saved = S21Matrix::GetThreadCount();
+
+  S21Matrix::SetThreadCount(1);
+  EXPECT_EQ(S21Matrix::GetThreadCount(), 1);
+  S21Matrix serial = a * b;
+  S21Matrix::SetThreadCount(4);
+  EXPECT_EQ(S21Matrix::GetThreadCount(), 4);
+  S21Matrix parallel = a * b;
+  S21Matrix::SetThreadCount(saved);
+
+  for (int i = 0; i < n; i++)
+    for (int j = 0; j < n; j++) ASSERT_EQ(serial(i, j), parallel(i, j));
+}
+
+TEST(func8, det_large) {
+  const int size = 200;
+  S21Matrix m(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) m(i, j) = (i == j) ? 2.0 : 0.0;
+  }
+  // Перестановка двух строк меняет знак
+  m(0, 0) = 0;
+  m(0, 1) = 2;
+  m(1, 1) = 0;
+  m(1, 0) = 2;
+  m(5, 3) = 7;
+  ASSERT_NEAR(-std::pow(2.0, size), m.Determinant(),
+              std::pow(2.0, size) * 1e-12);
+}
+
+TEST(func9, inverse_large) {
+  const int size = 120;
+  S21Matrix m(size, size);
+  for (int i = 0; i < size; i++) {
+    for (int j = 0; j < size; j++) {
+      m(i, j) = std::sin(i * 1.3 + j * 0.7) + (i == j ? size : 0);
+    }
+  }
+  // Ведущий элемент первого столбца не на диагонали
+  m(0, 0) = 0.5;
+  S21Matrix product = m * m.InverseMatrix();
+  S21Matrix identity(size, size);
+  for (int i = 0; i < size; i++) identity(i, i) = 1;
+  EXPECT_TRUE(product == identity);
+}
+
+TEST(func9, inverse_singular) {
+  S21Matrix m(3, 3);
+  for (int i = 0, c = 1; i < 3; i++)
+    for (int j = 0; j < 3; j++, c++) m(i, j) = c;
+  EXPECT_THROW(m.InverseMatrix(), std::out_of_range);
+}
+
+TEST(lu, solve) {
+  S21Matrix a(3, 3);
+  a(0, 0) = 2;
+  a(0, 1) = 5;
+  a(0, 2) = 7;
+  a(1, 0) = 6;
+  a(1, 1) = 3;
+  a(1, 2) = 4;
+  a(2, 0) = 5;
+  a(2, 1) = -2;
+  a(2, 2) = -3;
+  S21LU lu = a.LU();
+  EXPECT_EQ(lu.GetSize(), 3);
+  EXPECT_FALSE(lu.IsSingular());
+  EXPECT_NEAR(lu.Determinant(), a.Determinant(), 1e-9);
+
+  std::vector<double> x = lu.Solve(std::vector<double>{1, 2, 3});
+  for (int i = 0; i < 3; i++) {
+    double sum = 0;
+    for (int j = 0; j < 3; j++) sum += a(i, j) * x[j];
+    EXPECT_NEAR(sum, i + 1, 1e-9);
+  }
+
+  S21Matrix b(3, 4);
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 4; j++) b(i, j) = i * 4 + j - 5;
+  S21Matrix xs = lu.Solve(b);
+  EXPECT_TRUE(a * xs == b);
+  EXPECT_TRUE(lu.Inverse() == a.InverseMatrix());
+  EXPECT_THROW(lu.Solve(std::vector<double>{1, 2}), std::invalid_argument);
+}
+
+TEST(lu, singular) {
+  S21Matrix a(2, 2);
+  a(0, 0) = 1;
+  a(0, 1) = 2;
+  a(1, 0) = 2;
+  a(1, 1) = 4;
+  S21LU lu(a);
+  EXPECT_TRUE(lu.IsSingular());
+  EXPECT_EQ(lu.Determinant(), 0);
+  EXPECT_THROW(lu.Solve(std::vector<double>{1, 2}), std::out_of_range);
+  EXPECT_THROW(lu.Inverse(), std::out_of_range);
+  EXPECT_THROW(S21LU(S21Matrix(2, 3)), std::invalid_argument);
+}
+
+TEST(lu, badly_scaled_determinant) {
+  S21Matrix a(2, 2);
+  a(0, 0) = 1e10;
+  a(1, 1) = 1e-7;
+  EXPECT_DOUBLE_EQ(a.Determinant(), 1000);
+  EXPECT_DOUBLE_EQ(S21LU(a).Determinant(), 1000);
+
+  S21Matrix b(3, 3);
+  b(0, 0) = 1;
+  b(1, 1) = 1;
+  b(2, 2) = 1e-17;
+  EXPECT_DOUBLE_EQ(b.Determinant(), 1e-17);
+  EXPECT_DOUBLE_EQ(S21LU(b).Determinant(), 1e-17);
+
+  // Порядок больше 4 считается только через LU-разложение
+  S21Matrix c(6, 6);
+  for (int i = 0; i < 6; i++) c(i, i) = 1;
+  c(5, 5) = 1e-17;
+  c(0, 5) = 3;
+  EXPECT_DOUBLE_EQ(c.Determinant(), 1e-17);
+}
+
+TEST(lu, badly_scaled_inverse) {
+  S21Matrix a(2, 2);
+  a(0, 0) = 1e10;
+  a(1, 1) = 1e-7;
+  EXPECT_FALSE(S21LU(a).IsSingular());
+  S21Matrix inv = a.InverseMatrix();
+  EXPECT_DOUBLE_EQ(inv(0, 0), 1e-10);
+  EXPECT_DOUBLE_EQ(inv(1, 1), 1e7);
+
+  // Строки разного масштаба: после деления строк на 1e10 и 1e-7
+  // матрица ((1, 1), (1, 2)) хорошо обусловлена
+  S21Matrix b(2, 2);
+  b(0, 0) = 1e10;
+  b(0, 1) = 1e10;
+  b(1, 0) = 1e-7;
+  b(1, 1) = 2e-7;
+  S21Matrix b_inv = b.InverseMatrix();
+  EXPECT_NEAR(b_inv(0, 0), 2e-10, 1e-24);
+  EXPECT_NEAR(b_inv(0, 1), -1e7, 1e-6);
+  EXPECT_NEAR(b_inv(1, 0), -1e-10, 1e-24);
+  EXPECT_NEAR(b_inv(1, 1), 1e7, 1e-6);
+
+  // Вырожденная матрица остаётся вырожденной при любом масштабе
+  S21Matrix c(3, 3);
+  for (int i = 0, v = 1; i < 3; i++)
+    for (int j = 0; j < 3; j++, v++) c(i, j) = v * 1e-12;
+  EXPECT_TRUE(S21LU(c).IsSingular());
+  EXPECT_THROW(c.InverseMatrix(), std::out_of_range);
+}
+
+TEST(simd, every_isa_matches_scalar) {
+  const int rows = 7, cols = 9;
+  S21Matrix a(rows, cols), b(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      a(i, j) = i * 0.5 - j * 0.25;
+      b(i, j) = j * 1.5 + i;
+    }
+  }
+  const s21::simd::Isa saved = s21::simd::ActiveIsa();
+  ASSERT_TRUE(s21::simd::SetIsa(s21::simd::Isa::kScalar));
+  S21Matrix expected = a;
+  expected.SumMatrix(b);
+  expected.MulNumber(-3.25);
+  expected.SubMatrix(a);
+
+  for (s21::simd::Isa isa :
+       {s21::simd::Isa::kSse2, s21::simd::Isa::kAvx2, s21::simd::Isa::kAvx512}) {
+    if (!s21::simd::SetIsa(isa)) continue;
+    S21Matrix actual = a;
+    actual.SumMatrix(b);
+    actual.MulNumber(-3.25);
+    actual.SubMatrix(a);
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < cols; j++) ASSERT_EQ(actual(i, j), expected(i, j));
+    EXPECT_TRUE(actual.EqMatrix(expected));
+    actual(rows - 1, cols - 1) += 1e-6;
+    EXPECT_FALSE(actual.EqMatrix(expected));
+    actual(rows - 1, cols - 1) = expected(rows - 1, cols - 1);
+    actual(0, 1) -= 1e-6;
+    EXPECT_FALSE(actual.EqMatrix(expected));
+  }
+  s21::simd::SetIsa(saved);
+}
+
+TEST(expr, fused_chain) {
+  S21Matrix a(2, 3), b(2, 3), c(2, 3);
+  for (int i = 0; i < 2; i++) {
+    for (int j = 0; j < 3; j++) {
+      a(i, j) = i + j;
+      b(i, j) = i * j;
+      c(i, j) = j - i;
+    }
+  }
+  S21Matrix result = a + b - 2.0 * c;
+  for (int i = 0; i < 2; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_DOUBLE_EQ(result(i, j), (i + j) + (i * j) - 2.0 * (j - i));
+
+  // Выражение, ссылающееся на саму матрицу-приёмник
+  a = a * 0.5 + a;
+  EXPECT_DOUBLE_EQ(a(1, 2), 4.5);
+  a += b - c;
+  EXPECT_DOUBLE_EQ(a(1, 2), 4.5 + 2 - 1);
+  a -= 3 * b;
+  EXPECT_DOUBLE_EQ(a(1, 2), 5.5 - 6);
+
+  S21Matrix d(3, 2);
+  EXPECT_THROW(S21Matrix(a + d), std::invalid_argument);
+  EXPECT_THROW(a += d * 2, std::invalid_argument);
+  d = a - b;
+  EXPECT_EQ(d.GetRows(), 2);
+  EXPECT_EQ(d.GetCols(), 3);
+}
+
+// Вызовы, которые компилировались, пока + и - возвращали S21Matrix
+TEST(expr, matrix_call_shapes) {
+  S21Matrix a(3, 3), b(3, 3), c(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) {
+      a(i, j) = (i * 3 + j) % 4 + (i == j ? 5 : 0);
+      b(i, j) = i - j;
+      c(i, j) = i + 2 * j;
+    }
+  }
+  S21Matrix sum(a), diff(a);
+  sum.SumMatrix(b);
+  diff.SubMatrix(b);
+  S21Matrix product(diff);
+  product.MulMatrix(c);
+
+  S21Matrix d = (a - b) * c;
+  EXPECT_TRUE(d == product);
+  EXPECT_TRUE(a * (b + c) == a * S21Matrix(b + c));
+  EXPECT_TRUE((a + b) * (a - b) == sum * diff);
+  EXPECT_TRUE((a + b) == sum);
+  EXPECT_TRUE(sum == (a + b));
+  EXPECT_FALSE((a - b) == sum);
+  EXPECT_TRUE((a + b).EqMatrix(sum));
+  EXPECT_TRUE((2.0 * a).EqMatrix(a + a));
+  EXPECT_EQ((a + b).GetRows(), 3);
+  EXPECT_EQ((a + b).GetCols(), 3);
+  EXPECT_DOUBLE_EQ((a + b).Determinant(), sum.Determinant());
+  EXPECT_TRUE((a + b).Transpose() == sum.Transpose());
+  EXPECT_TRUE((a + b).CalcComplements() == sum.CalcComplements());
+  EXPECT_TRUE((a + b).InverseMatrix() == sum.InverseMatrix());
+  EXPECT_DOUBLE_EQ((a + b)(1, 2), sum(1, 2));
+  EXPECT_THROW((a + b)(3, 0), std::out_of_range);
+  EXPECT_THROW((a + b) * S21Matrix(2, 2), std::invalid_argument);
+
+  const S21Matrix& constant = a;
+  EXPECT_TRUE(constant == a);
+  EXPECT_TRUE(constant.EqMatrix(a));
+}
+
+TEST(rvalue, reuses_temporaries) {
+  const int n = 8;
+  S21Matrix a(n, n), b(n, n), c(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a(i, j) = i + j;
+      b(i, j) = i - j;
+      c(i, j) = i * j;
+    }
+  }
+  S21Matrix ab = a * b, ba = b * a;
+  S21Matrix expected = 2.0 * (ab + c) - a;
+
+  long before = aligned_allocations;
+  S21Matrix result = 2.0 * ((a * b) + c) - a;
+  EXPECT_EQ(aligned_allocations - before, 1);
+  EXPECT_TRUE(result == expected);
+
+  before = aligned_allocations;
+  S21Matrix chain = (a * b) * c;
+  EXPECT_EQ(aligned_allocations - before, 2);
+  EXPECT_TRUE(chain == ab * c);
+
+  before = aligned_allocations;
+  S21Matrix both = (a * b) - (b * a);
+  EXPECT_EQ(aligned_allocations - before, 2);
+  EXPECT_TRUE(both == ab - ba);
+
+  EXPECT_THROW(S21Matrix(S21Matrix(2, 3) + c), std::invalid_argument);
+  EXPECT_THROW(S21Matrix(c - S21Matrix(2, 3)), std::invalid_argument);
+}
+
+TEST(transpose, blocked) {
+  const int rows = 37, cols = 70;
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; i++)
+    for (int j = 0; j < cols; j++) m(i, j) = i * 1000 + j;
+
+  const s21::simd::Isa saved = s21::simd::ActiveIsa();
+  for (s21::simd::Isa isa : {s21::simd::Isa::kScalar, s21::simd::Isa::kSse2,
+                             s21::simd::Isa::kAvx2}) {
+    if (!s21::simd::SetIsa(isa)) continue;
+    S21Matrix t = m.Transpose();
+    ASSERT_EQ(t.GetRows(), cols);
+    ASSERT_EQ(t.GetCols(), rows);
+    for (int i = 0; i < rows; i++)
+      for (int j = 0; j < cols; j++) ASSERT_EQ(t(j, i), m(i, j));
+  }
+  s21::simd::SetIsa(saved);
+}
+
+TEST(transpose, in_place) {
+  const int size = 70;
+  S21Matrix m(size, size);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) m(i, j) = i * 1000 + j;
+
+  long before = aligned_allocations;
+  m.TransposeInPlace();
+  EXPECT_EQ(aligned_allocations - before, 0);
+  for (int i = 0; i < size; i++)
+    for (int j = 0; j < size; j++) ASSERT_EQ(m(i, j), j * 1000 + i);
+
+  S21Matrix r(2, 3);
+  r(0, 2) = 5;
+  r.TransposeInPlace();
+  EXPECT_EQ(r.GetRows(), 3);
+  EXPECT_EQ(r.GetCols(), 2);
+  EXPECT_EQ(r(2, 0), 5);
+}
+
+TEST(view, slices) {
+  S21Matrix m(4, 5);
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 5; j++) m(i, j) = i * 10 + j;
+
+  S21MatrixView block = m.BlockView(1, 2, 2, 3);
+  EXPECT_EQ(block.GetRows(), 2);
+  EXPECT_EQ(block.GetCols(), 3);
+  EXPECT_EQ(block(1, 2), 24);
+  EXPECT_EQ(m.RowView(3)(0, 4), 34);
+  EXPECT_EQ(m.ColView(1)(2, 0), 21);
+  EXPECT_EQ(m.TransposedView()(4, 3), 34);
+  EXPECT_EQ(block.Transposed()(2, 0), 14);
+  EXPECT_THROW(m.BlockView(3, 3, 2, 1), std::out_of_range);
+  EXPECT_THROW(block(2, 0), std::out_of_range);
+
+  // Запись через окно меняет исходную матрицу
+  block(0, 0) = -1;
+  EXPECT_EQ(m(1, 2), -1);
+  m.RowView(0).MulNumber(2);
+  EXPECT_EQ(m(0, 4), 8);
+  m.ColView(0).Transposed().MulNumber(0);
+  EXPECT_EQ(m(3, 0), 0);
+
+  S21Matrix copy = m.BlockView(0, 0, 2, 2);
+  EXPECT_EQ(copy.GetRows(), 2);
+  EXPECT_EQ(copy(1, 1), 11);
+}
+
+TEST(view, arithmetic) {
+  const int n = 40;
+  S21Matrix a(n, n), b(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a(i, j) = std::sin(i + 2.0 * j);
+      b(i, j) = std::cos(3.0 * i - j);
+    }
+  }
+
+  S21Matrix expected = a * b.Transpose();
+  S21Matrix product = a;
+  product.MulMatrix(b.TransposedView());
+  EXPECT_TRUE(product == expected);
+  EXPECT_TRUE(a.View() * b.TransposedView() == expected);
+
+  S21Matrix top = a.BlockView(0, 0, 10, n) * b.BlockView(0, 0, n, 7);
+  for (int i = 0; i < 10; i++)
+    for (int j = 0; j < 7; j++) EXPECT_NEAR(top(i, j), (a * b)(i, j), 1e-12);
+
+  // Присваивание транспонированного окна самой матрице
+  S21Matrix t = a;
+  t = t.TransposedView();
+  EXPECT_TRUE(t == a.Transpose());
+  t += t.TransposedView();
+  EXPECT_TRUE(t == a.Transpose() + a);
+
+  S21Matrix sum = a;
+  sum.SumMatrix(b.TransposedView());
+  EXPECT_TRUE(sum == a + b.TransposedView());
+  sum.SubMatrix(b.TransposedView());
+  EXPECT_TRUE(sum == a);
+
+  // Пересекающиеся окна одной матрицы
+  S21Matrix shifted = a;
+  shifted.BlockView(1, 0, n - 1, n).SumMatrix(shifted.BlockView(0, 0, n - 1, n));
+  for (int j = 0; j < n; j++) EXPECT_DOUBLE_EQ(shifted(2, j), a(2, j) + a(1, j));
+
+  S21LU lu(a.BlockView(0, 0, 5, 5));
+  EXPECT_NEAR(lu.Determinant(), S21Matrix(a.BlockView(0, 0, 5, 5)).Determinant(),
+              1e-12);
+}
+
+TEST(allocator, pool_reuses_blocks) {
+  S21MatrixAllocator::SetCurrent(S21PoolAllocator::Instance());
+  S21Matrix warm(10, 10);
+  warm(9, 9) = 1.0;
+  warm = S21Matrix();
+
+  long before = aligned_allocations;
+  for (int k = 0; k < 100; k++) {
+    S21Matrix m(10, 10);
+    EXPECT_DOUBLE_EQ(m(9, 9), 0.0);
+    m(9, 9) = k;
+    S21Matrix sum = m + m;
+    EXPECT_DOUBLE_EQ(sum(9, 9), 2.0 * k);
+  }
+  EXPECT_EQ(aligned_allocations - before, 1);
+
+  S21MatrixAllocator::SetCurrent(nullptr);
+  EXPECT_EQ(S21MatrixAllocator::Current(), S21MatrixAllocator::Default());
+  S21PoolAllocator::ReleaseThreadCache();
+}
+
+TEST(allocator, arena_scope) {
+  S21Matrix outside(5, 5);
+  outside(0, 0) = 1.0;
+  {
+    S21MatrixArena arena;
+    EXPECT_EQ(S21MatrixAllocator::Current(), &arena);
+    long before = aligned_allocations;
+    S21Matrix acc(16, 16);
+    for (int k = 0; k < 50; k++) {
+      S21Matrix tmp(16, 16);
+      tmp(0, 0) = k;
+      acc += tmp;
+    }
+    EXPECT_DOUBLE_EQ(acc(0, 0), 49.0 * 50 / 2);
+    EXPECT_EQ(aligned_allocations - before, 1);
+    EXPECT_GE(arena.BytesUsed(), 16 * 16 * sizeof(double));
+    // Матрица, созданная до арены, освобождается своим аллокатором
+    S21Matrix moved = std::move(outside);
+    EXPECT_DOUBLE_EQ(moved(0, 0), 1.0);
+  }
+  EXPECT_EQ(S21MatrixAllocator::Current(), S21MatrixAllocator::Default());
+  S21Matrix after(3, 3);
+  after(2, 2) = 2.0;
+  EXPECT_DOUBLE_EQ(after(2, 2), 2.0);
+}
+
+template <int N>
+void ExpectFixedMatchesDynamic(const S21FixedMatrix<N, N>& fixed) {
+  S21Matrix dynamic(fixed);
+  EXPECT_NEAR(fixed.Determinant(), dynamic.Determinant(), 1e-9);
+  EXPECT_TRUE(S21Matrix(fixed.CalcComplements()) == dynamic.CalcComplements());
+  EXPECT_TRUE(S21Matrix(fixed.InverseMatrix()) == dynamic.InverseMatrix());
+}
+
+TEST(fixed, closed_forms_match_dynamic) {
+  ExpectFixedMatchesDynamic(S21FixedMatrix<1, 1>({4.0}));
+  ExpectFixedMatchesDynamic(S21FixedMatrix<2, 2>({3, 1, -2, 5}));
+  ExpectFixedMatchesDynamic(S21FixedMatrix<3, 3>({2, 5, 7, 6, 3, 4, 5, -2, -3}));
+  ExpectFixedMatchesDynamic(S21FixedMatrix<4, 4>(
+      {1, 2, 0, 3, -1, 4, 2, 1, 3, 0, 5, -2, 2, 1, 1, 6}));
+  ExpectFixedMatchesDynamic(S21FixedMatrix<5, 5>(
+      {2, 1, 0, 0, 3, 1, 3, 1, 0, 0, 0, 1, 4, 1, 2, 0, 0, 1, 5, 1, 1, 2, 0, 1, 6}));
+
+  S21FixedMatrix<3, 3> singular({1, 2, 3, 4, 5, 6, 7, 8, 9});
+  EXPECT_DOUBLE_EQ(singular.Determinant(), 0);
+  EXPECT_THROW(singular.InverseMatrix(), std::out_of_range);
+
+  // Вырожденность — по тому же правилу, что и у S21Matrix
+  S21FixedMatrix<3, 3> scaled = singular * 1e-12;
+  EXPECT_THROW(scaled.InverseMatrix(), std::out_of_range);
+  EXPECT_THROW(S21Matrix(scaled).InverseMatrix(), std::out_of_range);
+  S21FixedMatrix<2, 2> diagonal({1e10, 0, 0, 1e-7});
+  EXPECT_DOUBLE_EQ(diagonal.InverseMatrix()(1, 1), 1e7);
+}
+
+TEST(fixed, arithmetic_and_conversion) {
+  constexpr S21FixedMatrix<2, 3> a({1, 2, 3, 4, 5, 6});
+  constexpr S21FixedMatrix<3, 2> b = a.Transpose();
+  constexpr S21FixedMatrix<2, 2> ab = a * b;
+  static_assert(ab(0, 0) == 14 && ab(0, 1) == 32 && ab(1, 1) == 77);
+  static_assert(ab.Determinant() == 14 * 77 - 32 * 32);
+  static_assert((a + a - a * 2.0) == S21FixedMatrix<2, 3>());
+  static_assert(S21FixedMatrix<2, 3>::kEpsilon == S21Matrix::kEpsilon);
+
+  S21FixedMatrix<2, 3> c = a;
+  c *= S21FixedMatrix<3, 3>({1, 0, 0, 0, 2, 0, 0, 0, 3});
+  EXPECT_DOUBLE_EQ(c(1, 2), 18);
+  EXPECT_THROW(c(2, 0), std::out_of_range);
+
+  S21Matrix dynamic(c);
+  EXPECT_EQ(dynamic.GetRows(), 2);
+  EXPECT_EQ(dynamic.GetCols(), 3);
+  EXPECT_TRUE((S21FixedMatrix<2, 3>(dynamic) == c));
+  EXPECT_THROW((S21FixedMatrix<3, 2>(dynamic)), std::invalid_argument);
+}
+
+TEST(storage, small_buffer) {
+  long before = aligned_allocations;
+  S21Matrix a(4, 4);
+  for (int i = 0; i < 4; i++)
+    for (int j = 0; j < 4; j++) a(i, j) = i * 4 + j;
+  S21Matrix b(a);
+  S21Matrix c = std::move(b);
+  EXPECT_EQ(b.GetRows(), 0);
+  EXPECT_TRUE(c == a);
+  S21Matrix d = a * c + a;
+  d = a.Transpose();
+  EXPECT_DOUBLE_EQ(d(3, 0), 3.0);
+  EXPECT_EQ(aligned_allocations - before, 0);
+
+  // Переход через порог встроенного буфера в обе стороны
+  c.SetRows(6);
+  EXPECT_EQ(aligned_allocations - before, 1);
+  EXPECT_DOUBLE_EQ(c(3, 3), 15.0);
+  EXPECT_DOUBLE_EQ(c(5, 3), 0.0);
+  S21Matrix heap = std::move(c);
+  EXPECT_DOUBLE_EQ(heap(3, 2), 14.0);
+  heap.SetCols(2);
+  EXPECT_EQ(heap.GetRows(), 6);
+  EXPECT_DOUBLE_EQ(heap(3, 1), 13.0);
+  heap.SetRows(2);
+  c = std::move(heap);
+  EXPECT_DOUBLE_EQ(c(1, 1), 5.0);
+  a = c;
+  EXPECT_TRUE(a == c);
+  EXPECT_EQ(aligned_allocations - before, 1);
+}
+
+template <typename T>
+void ExpectElementTypeKernels() {
+  const int m = 70, k = 300, n = 45;
+  S21BasicMatrix<T> a(m, k), b(k, n);
+  for (int i = 0; i < m; i++)
+    for (int j = 0; j < k; j++) a(i, j) = (i * 7 + j * 3) % 11 - 5;
+  for (int i = 0; i < k; i++)
+    for (int j = 0; j < n; j++) b(i, j) = (i * 5 + j * 2) % 13 - 6;
+
+  // Целые значения и суммы представимы точно во всех типах
+  S21BasicMatrix<T> c = a * b;
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < n; j++) {
+      T sum = 0;
+      for (int p = 0; p < k; p++) sum += a(i, p) * b(p, j);
+      ASSERT_EQ(c(i, j), sum);
+    }
+  }
+
+  const s21::simd::Isa saved = s21::simd::ActiveIsa();
+  ASSERT_TRUE(s21::simd::SetIsa(s21::simd::Isa::kScalar));
+  S21BasicMatrix<T> expected = 2.0 * (a + a) - a;
+  S21BasicMatrix<T> transposed = a.Transpose();
+  for (s21::simd::Isa isa : {s21::simd::Isa::kSse2, s21::simd::Isa::kAvx2,
+                             s21::simd::Isa::kAvx512}) {
+    if (!s21::simd::SetIsa(isa)) continue;
+    S21BasicMatrix<T> actual = a;
+    actual.SumMatrix(a);
+    actual.MulNumber(2);
+    actual.SubMatrix(a);
+    EXPECT_TRUE(actual == expected);
+    EXPECT_TRUE(a.Transpose() == transposed);
+    actual(m - 1, k - 1) += 4 * S21BasicMatrix<T>::kEpsilon;
+    EXPECT_FALSE(actual == expected);
+  }
+  s21::simd::SetIsa(saved);
+
+  S21BasicMatrix<T> s(3, 3);
+  const T values[] = {2, 5, 7, 6, 3, 4, 5, -2, -3};
+  for (int i = 0; i < 9; i++) s(i / 3, i % 3) = values[i];
+  EXPECT_NEAR(static_cast<double>(s.Determinant()), -1.0, 1e-4);
+  S21BasicMatrix<T> identity = s * s.InverseMatrix();
+  for (int i = 0; i < 3; i++)
+    for (int j = 0; j < 3; j++)
+      EXPECT_NEAR(static_cast<double>(identity(i, j)), i == j, 1e-4);
+}
+
+TEST(element_type, float_and_long_double) {
+  ExpectElementTypeKernels<float>();
+  ExpectElementTypeKernels<long double>();
+
+  // Допуск EqMatrix зависит от типа элементов
+  S21BasicMatrix<float> x(2, 2), y(2, 2);
+  y(1, 1) = 5E-05f;
+  EXPECT_TRUE(x == y);
+  y(1, 1) = 5E-04f;
+  EXPECT_FALSE(x == y);
+  S21Matrix u(2, 2), v(2, 2);
+  v(1, 1) = 5E-05;
+  EXPECT_FALSE(u == v);
+}
+
+S21MatrixBatch FillBatch(int count, int rows, int cols) {
+  S21MatrixBatch batch(count, rows, cols);
+  for (int index = 0; index < count; index++) {
+    for (int i = 0; i < rows; i++) {
+      for (int j = 0; j < cols; j++) {
+        batch(index, i, j) =
+            (index * 7 + i * 5 + j * 3) % 11 - 5 + (i == j ? 6 * rows : 0);
+      }
+    }
+  }
+  return batch;
+}
+
+TEST(batch, closed_forms_match_dynamic) {
+  // Число матриц не кратно kLanes, чтобы задеть дополнение набора
+  const int count = 1000;
+  const s21::simd::Isa saved = s21::simd::ActiveIsa();
+  for (s21::simd::Isa isa : {s21::simd::Isa::kScalar, s21::simd::Isa::kAvx2,
+                             s21::simd::Isa::kAvx512}) {
+    if (!s21::simd::SetIsa(isa)) continue;
+    for (int n = 1; n <= 5; n++) {
+      S21MatrixBatch batch = FillBatch(count, n, n);
+      std::vector<double> det = batch.Determinant();
+      S21MatrixBatch inverse = batch.InverseMatrix();
+      ASSERT_EQ(det.size(), static_cast<std::size_t>(count));
+      for (int index = 0; index < count; index += 37) {
+        S21Matrix single = batch.GetMatrix(index);
+        const double expected = single.Determinant();
+        EXPECT_NEAR(det[index], expected, 1e-9 * std::abs(expected));
+        EXPECT_TRUE(inverse.GetMatrix(index) == single.InverseMatrix());
+      }
+    }
+  }
+  s21::simd::SetIsa(saved);
+
+  S21MatrixBatch singular = FillBatch(20, 3, 3);
+  singular.SetMatrix(13, S21Matrix(3, 3));
+  EXPECT_DOUBLE_EQ(singular.Determinant()[13], 0);
+  EXPECT_THROW(singular.InverseMatrix(), std::out_of_range);
+
+  // Вырожденность — по тому же правилу, что и у S21Matrix: масштаб
+  // матрицы не влияет на решение
+  S21Matrix scaled(3, 3);
+  for (int i = 0; i < 3; i++) {
+    for (int j = 0; j < 3; j++) scaled(i, j) = (i * 3 + j + 1) * 1e-12;
+  }
+  S21MatrixBatch tiny = FillBatch(20, 3, 3);
+  tiny.SetMatrix(7, scaled);
+  EXPECT_THROW(tiny.InverseMatrix(), std::out_of_range);
+  S21Matrix diagonal(2, 2);
+  diagonal(0, 0) = 1e10;
+  diagonal(1, 1) = 1e-7;
+  S21MatrixBatch wide = FillBatch(20, 2, 2);
+  wide.SetMatrix(5, diagonal);
+  EXPECT_DOUBLE_EQ(wide.InverseMatrix()(5, 1, 1), 1e7);
+
+  // Около порога отсев не меняет решение: набор и S21Matrix согласны
+  for (int power = 8; power <= 17; power++) {
+    S21Matrix near(4, 4);
+    for (int i = 0; i < 4; i++) {
+      for (int j = 0; j < 4; j++) near(i, j) = 1 + (i == j ? i : 0);
+    }
+    near(3, 3) = near(2, 3) + std::pow(10.0, -power);
+    bool single_throws = false;
+    try {
+      near.InverseMatrix();
+    } catch (const std::out_of_range&) {
+      single_throws = true;
+    }
+    S21MatrixBatch one = FillBatch(3, 4, 4);
+    one.SetMatrix(1, near);
+    bool batch_throws = false;
+    try {
+      one.InverseMatrix();
+    } catch (const std::out_of_range&) {
+      batch_throws = true;
+    }
+    EXPECT_EQ(batch_throws, single_throws) << "power " << power;
+  }
+  EXPECT_THROW(FillBatch(4, 2, 3).Determinant(), std::invalid_argument);
+  EXPECT_THROW(S21MatrixBatch(4, 0, 3), std::out_of_range);
+}
+
+TEST(batch, multiply) {
+  const int count = 515;
+  S21MatrixBatch a = FillBatch(count, 3, 4);
+  S21MatrixBatch b = FillBatch(count, 4, 2);
+  S21MatrixBatch c = a;
+  c.MulMatrix(b);
+  EXPECT_EQ(c.GetRows(), 3);
+  EXPECT_EQ(c.GetCols(), 2);
+  for (int index = 0; index < count; index += 17) {
+    EXPECT_TRUE(c.GetMatrix(index) == a.GetMatrix(index) * b.GetMatrix(index));
+  }
+  EXPECT_THROW(c(count, 0, 0), std::out_of_range);
+  EXPECT_THROW(c.SetMatrix(0, S21Matrix(2, 2)), std::invalid_argument);
+  EXPECT_THROW(a.MulMatrix(a), std::invalid_argument);
+  EXPECT_THROW(a.MulMatrix(FillBatch(count + 1, 4, 2)), std::invalid_argument);
+}
+
+TEST(stats, counters) {
+  s21::stats::Reset();
+  S21Matrix a(20, 30), b(30, 10);
+  a(0, 0) = 2.0;
+  b(0, 0) = 3.0;
+  a.MulMatrix(b);
+  a.MulNumber(2.0);
+  std::thread worker([] {
+    S21Matrix c(5, 5);
+    c(4, 4) = 2.0;
+    EXPECT_DOUBLE_EQ(c.Transpose()(4, 4), 2.0);
+  });
+  worker.join();
+
+  const s21::stats::Snapshot snapshot = s21::stats::Collect();
+  const std::string json = s21::stats::ToJson(snapshot);
+  EXPECT_NE(json.find("\"MulMatrix\": {\"calls\": "), std::string::npos);
+  EXPECT_NE(json.find("\"bytes_allocated\": "), std::string::npos);
+  using s21::stats::Op;
+  if (s21::stats::kEnabled) {
+    EXPECT_EQ(snapshot[Op::kMulMatrix].calls, 1u);
+    EXPECT_EQ(snapshot[Op::kMulMatrix].flops, 2u * 20 * 30 * 10);
+    EXPECT_EQ(snapshot[Op::kMulNumber].flops, 20u * 10);
+    // Транспонирование из завершившегося потока не теряется
+    EXPECT_EQ(snapshot[Op::kTranspose].calls, 1u);
+    EXPECT_EQ(snapshot.allocations, 5u);
+    EXPECT_GE(snapshot.bytes_allocated,
+              (20u * 30 + 30 * 10 + 20 * 10 + 2 * 25) * sizeof(double));
+  } else {
+    EXPECT_EQ(snapshot[Op::kMulMatrix].calls, 0u);
+    EXPECT_EQ(snapshot.allocations, 0u);
+  }
+  s21::stats::Reset();
+  EXPECT_EQ(s21::stats::Collect()[Op::kMulMatrix].calls, 0u);
+
+  // TransposeInPlace учитывается один раз при любой форме матрицы
+  S21Matrix square(3, 3);
+  square.TransposeInPlace();
+  a.TransposeInPlace();
+  EXPECT_EQ(s21::stats::Collect()[Op::kTranspose].calls,
+            s21::stats::kEnabled ? 2u : 0u);
+  s21::stats::Reset();
+}
+
+double CofactorByDeterminant(S21Matrix& a, int x, int y) {
+  const int n = a.GetRows();
+  S21Matrix sub(n - 1, n - 1);
+  for (int i = 0, si = 0; i < n; i++) {
+    if (i == x) continue;
+    for (int j = 0, sj = 0; j < n; j++) {
+      if (j != y) sub(si, sj++) = a(i, j);
+    }
+    si++;
+  }
+  return ((x + y) % 2 ? -1 : 1) * sub.Determinant();
+}
+
+TEST(complements, lu_and_minor_paths) {
+  // Больше одного блока столбцов на решение
+  const int n = 70;
+  S21Matrix a(n, n);
+  for (int i = 0; i < n; i++) {
+    for (int j = 0; j < n; j++) {
+      a(i, j) = ((i * 13 + j * 7) % 17) / 8.0 - 1 + (i == j ? 2 : 0);
+    }
+  }
+  S21Matrix c = a.CalcComplements();
+  for (int k = 0; k < n; k += 9) {
+    const int j = (k * 5) % n;
+    EXPECT_NEAR(c(k, j), CofactorByDeterminant(a, k, j),
+                1e-9 * std::abs(c(k, j)) + 1e-9);
+  }
+
+  // Вырожденная матрица ранга n - 1: дополнения через миноры
+  const int m = 6;
+  S21Matrix s(m, m);
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) s(i, j) = (i * 3 + j * j) % 7 + (i == j);
+  }
+  for (int j = 0; j < m; j++) s(m - 1, j) = s(0, j) + 2 * s(1, j);
+  ASSERT_TRUE(S21LU(s).IsSingular());
+  S21Matrix cs = s.CalcComplements();
+  for (int i = 0; i < m; i++) {
+    for (int j = 0; j < m; j++) {
+      EXPECT_NEAR(cs(i, j), CofactorByDeterminant(s, i, j), 1e-7);
+    }
+  }
+  // Для вырожденной A * C^T = det * E = 0
+  S21Matrix zero = s * cs.Transpose();
+  EXPECT_TRUE(zero == S21Matrix(m, m));
+}
+
+TEST(strassen, matches_classical_with_peeling) {
+  // Нечётные и неравные размеры на каждом уровне рекурсии
+  const int sizes[][3] = {{37, 53, 29}, {64, 64, 64}, {65, 40, 33}};
+  for (const auto& size : sizes) {
+    S21Matrix a(size[0], size[1]), b(size[1], size[2]);
+    for (int i = 0; i < size[0]; i++)
+      for (int j = 0; j < size[1]; j++) a(i, j) = std::sin(i * 0.7 + j * 1.3);
+    for (int i = 0; i < size[1]; i++)
+      for (int j = 0; j < size[2]; j++) b(i, j) = std::cos(i * 1.1 - j * 0.4);
+    S21Matrix classical = a * b;
+    for (int threshold : {4, 16, 512}) {
+      S21Matrix fast = a;
+      fast.MulMatrixStrassen(b, threshold);
+      ASSERT_EQ(fast.GetRows(), size[0]);
+      ASSERT_EQ(fast.GetCols(), size[2]);
+      const double bound =
+          a.StrassenErrorBound(b, threshold) + a.MulErrorBound(b);
+      for (int i = 0; i < size[0]; i++) {
+        for (int j = 0; j < size[2]; j++) {
+          ASSERT_NEAR(fast(i, j), classical(i, j), bound);
+        }
+      }
+    }
+  }
+
+  S21Matrix a(100, 100), b(100, 100);
+  a(0, 0) = 2;
+  b(0, 0) = 3;
+  // Без рекурсии оценки совпадают, с каждым уровнем растут
+  EXPECT_DOUBLE_EQ(a.StrassenErrorBound(b, 512), a.MulErrorBound(b));
+  EXPECT_GT(a.StrassenErrorBound(b, 16), a.StrassenErrorBound(b, 64));
+  EXPECT_THROW(a.MulMatrixStrassen(S21Matrix(3, 3)), std::invalid_argument);
+}
+
+TEST(capacity, append_rows_grows_geometrically) {
+  long before = aligned_allocations;
+  S21Matrix m;
+  for (int i = 0; i < 1000; i++) {
+    m.AppendRow({double(i), double(i) / 2, 1.0});
+  }
+  EXPECT_EQ(m.GetRows(), 1000);
+  EXPECT_EQ(m.GetCols(), 3);
+  EXPECT_GE(m.GetRowCapacity(), 1000);
+  // 1, 2, 4 ... 1024 строк, первые три блока встроенные
+  EXPECT_EQ(aligned_allocations - before, 8);
+  EXPECT_DOUBLE_EQ(m(999, 0), 999.0);
+  EXPECT_DOUBLE_EQ(m(500, 1), 250.0);
+  EXPECT_THROW(m.AppendRow({1.0}), std::invalid_argument);
+
+  S21Matrix copy(m);
+  EXPECT_TRUE(copy == m);
+  m.ShrinkToFit();
+  EXPECT_EQ(m.GetRowCapacity(), 1000);
+  EXPECT_TRUE(copy == m);
+}
+
+TEST(capacity, shrink_keeps_buffer) {
+  S21Matrix m(40, 40);
+  for (int i = 0; i < 40; i++)
+    for (int j = 0; j < 40; j++) m(i, j) = i * 40 + j + 1;
+  long before = aligned_allocations;
+  m.SetRows(10);
+  m.SetCols(5);
+  // Блок 40 x 40 вмещает 320 строк по 5 или 10 строк по 160 столбцов
+  EXPECT_EQ(m.GetRowCapacity(), 320);
+  EXPECT_EQ(m.GetColCapacity(), 160);
+  m.SetRows(30);
+  m.SetCols(20);
+  EXPECT_EQ(aligned_allocations - before, 0);
+  EXPECT_DOUBLE_EQ(m(9, 4), 9 * 40 + 5);
+  EXPECT_DOUBLE_EQ(m(9, 5), 0.0);
+  EXPECT_DOUBLE_EQ(m(20, 3), 0.0);
+
+  m.Reserve(100, 50);
+  EXPECT_EQ(aligned_allocations - before, 1);
+  EXPECT_DOUBLE_EQ(m(9, 4), 9 * 40 + 5);
+  m.SetRows(100);
+  m.SetCols(50);
+  EXPECT_EQ(aligned_allocations - before, 1);
+  // Рост сверх ёмкости удваивает её
+  m.SetCols(51);
+  EXPECT_EQ(m.GetColCapacity(), 100);
+  EXPECT_DOUBLE_EQ(m(0, 0), 1.0);
+  EXPECT_DOUBLE_EQ(m(99, 50), 0.0);
+  EXPECT_THROW(m.Reserve(-1, 2), std::out_of_range);
+}
+
+TEST(capacity, resize_empty_matrix) {
+  S21Matrix m;
+  m.SetRows(3);
+  EXPECT_EQ(m.GetRows(), 3);
+  EXPECT_EQ(m.GetCols(), 0);
+  m.SetCols(4);
+  EXPECT_EQ(m.GetRows(), 3);
+  EXPECT_EQ(m.GetCols(), 4);
+  EXPECT_DOUBLE_EQ(m(0, 0), 0.0);
+  m(2, 3) = 5;
+  EXPECT_DOUBLE_EQ(m(2, 3), 5.0);
+
+  // В обратном порядке и сразу за пределами встроенного буфера
+  S21Matrix n;
+  n.SetCols(30);
+  n.SetRows(20);
+  EXPECT_EQ(n.GetRows(), 20);
+  EXPECT_EQ(n.GetCols(), 30);
+  EXPECT_DOUBLE_EQ(n(19, 29), 0.0);
+  n(19, 29) = 1;
+  EXPECT_TRUE(n == S21Matrix(n));
+}
+
+// Около 5% ненулевых элементов в псевдослучайных позициях
+S21Matrix SparseFilled(int rows, int cols, unsigned seed) {
+  S21Matrix m(rows, cols);
+  for (int i = 0; i < rows; i++) {
+    for (int j = 0; j < cols; j++) {
+      seed = seed * 1103515245u + 12345u;
+      if ((seed >> 16) % 20 == 0) m(i, j) = (seed >> 8) % 17 - 8.0;
+    }
+  }
+  return m;
+}
+
+TEST(sparse, matches_dense) {
+  S21Matrix a = SparseFilled(150, 90, 1), b = SparseFilled(90, 70, 2);
+  S21Matrix c = SparseFilled(150, 90, 3);
+  S21SparseMatrix sa(a), sb(b), sc(c);
+  EXPECT_LT(sa.GetNonZeros(), 150 * 90 / 10);
+  S21Matrix dense_a = sa.ToDense();
+  EXPECT_TRUE(dense_a == a);
+  EXPECT_DOUBLE_EQ(sa(149, 89), a(149, 89));
+
+  S21Matrix product = a * b;
+  S21Matrix sparse_dense = sa * b;
+  EXPECT_TRUE(sparse_dense == product);
+  S21Matrix sparse_sparse = (sa * sb).ToDense();
+  EXPECT_TRUE(sparse_sparse == product);
+
+  S21Matrix sum = a + c * 2.0;
+  S21Matrix sparse_sum = (sa + sc * 2.0).ToDense();
+  EXPECT_TRUE(sparse_sum == sum);
+  sa.SubMatrix(sa);
+  EXPECT_EQ(sa.GetNonZeros(), 0);
+
+  S21Matrix at = a.Transpose();
+  S21Matrix sparse_at = S21SparseMatrix(a).Transpose().ToDense();
+  EXPECT_TRUE(sparse_at == at);
+
+  // Ядро Axpy даёт одинаковый результат на всех наборах инструкций
+  const s21::simd::Isa saved = s21::simd::ActiveIsa();
+  ASSERT_TRUE(s21::simd::SetIsa(s21::simd::Isa::kScalar));
+  S21Matrix expected = sc * b;
+  for (s21::simd::Isa isa :
+       {s21::simd::Isa::kSse2, s21::simd::Isa::kAvx2, s21::simd::Isa::kAvx512}) {
+    if (!s21::simd::SetIsa(isa)) continue;
+    S21Matrix actual = sc * b;
+    for (int i = 0; i < 150; i++)
+      for (int j = 0; j < 70; j++) ASSERT_EQ(actual(i, j), expected(i, j));
+  }
+  s21::simd::SetIsa(saved);
+}
+
+TEST(sparse, triplets) {
+  S21SparseMatrix m(3, 4, {{2, 1, 1.5}, {0, 3, 2.0}, {2, 1, 0.5}, {1, 0, 1.0},
+                           {1, 0, -1.0}});
+  EXPECT_EQ(m.GetNonZeros(), 2);
+  EXPECT_DOUBLE_EQ(m(2, 1), 2.0);
+  EXPECT_DOUBLE_EQ(m(0, 3), 2.0);
+  EXPECT_DOUBLE_EQ(m(1, 0), 0.0);
+  EXPECT_EQ(m.RowPointers(), std::vector<int>({0, 1, 1, 2}));
+  EXPECT_EQ(m.ColIndices(), std::vector<int>({3, 1}));
+  EXPECT_THROW(m(3, 0), std::out_of_range);
+  EXPECT_THROW(S21SparseMatrix(2, 2, {{2, 0, 1.0}}), std::out_of_range);
+  EXPECT_THROW(m * m, std::invalid_argument);
+  EXPECT_THROW(m.SumMatrix(S21SparseMatrix(4, 3)), std::invalid_argument);
+  m.MulNumber(0);
+  EXPECT_EQ(m.GetNonZeros(), 0);
+}
+
+TEST(io, save_load_map) {
+  const std::string path = "s21_matrix_test_io.bin";
+  S21Matrix a(5, 9);
+  for (int i = 0; i < 5; i++)
+    for (int j = 0; j < 9; j++) a(i, j) = i * 9 + j + 0.5;
+  // Строки с шагом больше числа столбцов записываются без промежутков
+  a.SetCols(7);
+  a.Save(path);
+
+  S21Matrix loaded = S21Matrix::Load(path);
+  EXPECT_EQ(loaded.GetRows(), 5);
+  EXPECT_EQ(loaded.GetCols(), 7);
+  EXPECT_TRUE(loaded == a);
+
+  long before = aligned_allocations;
+  S21Matrix mapped = S21Matrix::Map(path);
+  EXPECT_EQ(aligned_allocations - before, 0);
+  EXPECT_TRUE(mapped == a);
+  // Запись в отображение не доходит до файла
+  mapped(4, 6) = -1.0;
+  mapped.MulNumber(2.0);
+  EXPECT_DOUBLE_EQ(mapped(0, 1), 3.0);
+  EXPECT_TRUE(S21Matrix::Map(path) == a);
+  mapped.SetRows(6);
+  EXPECT_DOUBLE_EQ(mapped(4, 6), -2.0);
+  EXPECT_DOUBLE_EQ(mapped(5, 0), 0.0);
+
+  EXPECT_THROW(S21BasicMatrix<float>::Load(path), std::invalid_argument);
+  EXPECT_THROW(S21BasicMatrix<float>::Map(path), std::invalid_argument);
+  S21Matrix().Save(path);
+  EXPECT_EQ(S21Matrix::Map(path).GetRows(), 0);
+  EXPECT_EQ(S21Matrix::Load(path).GetCols(), 0);
+  std::remove(path.c_str());
+  EXPECT_THROW(S21Matrix::Load(path), std::runtime_error);
+  EXPECT_THROW(S21Matrix::Map(path), std::runtime_error);
+}
+
+TEST(stream, tiled_multiply_matches_in_memory) {
+  const std::string a_path = "s21_stream_a.bin", b_path = "s21_stream_b.bin",
+                    c_path = "s21_stream_c.bin";
+  S21Matrix a(70, 45), b(45, 33);
+  for (int i = 0; i < 70; i++)
+    for (int j = 0; j < 45; j++) a(i, j) = (i * 7 + j * 3) % 11 - 5;
+  for (int i = 0; i < 45; i++)
+    for (int j = 0; j < 33; j++) b(i, j) = (i * 5 + j) % 9 * 0.5 - 2;
+  a.Save(a_path);
+  b.Save(b_path);
+  S21Matrix expected = a * b;
+
+  // Плитки 16 x 16: 5 x 3 плиток C по 3 панели
+  s21::io::StreamOptions options;
+  options.memory_budget = 5 * 16 * 16 * sizeof(double);
+  std::int64_t calls = 0, last = 0, total = 0;
+  options.progress = [&](std::int64_t done, std::int64_t all) {
+    calls++;
+    EXPECT_EQ(done, last + 1);
+    last = done;
+    total = all;
+  };
+  s21::io::StreamStats stats =
+      s21::io::MulMatrixFiles<double>(a_path, b_path, c_path, options);
+  EXPECT_EQ(stats.tile, 16);
+  EXPECT_EQ(total, 5 * 3 * 3);
+  EXPECT_EQ(calls, total);
+  EXPECT_EQ(stats.bytes_written, 70u * 33 * sizeof(double));
+  EXPECT_EQ(stats.bytes_read, (70u * 45 * 3 + 45u * 33 * 5) * sizeof(double));
+  S21Matrix c = S21Matrix::Load(c_path);
+  EXPECT_TRUE(c == expected);
+
+  // Всё помещается в бюджет: один шаг
+  stats = s21::io::MulMatrixFiles<double>(a_path, b_path, c_path);
+  EXPECT_EQ(stats.tile, 70);
+  c = S21Matrix::Map(c_path);
+  EXPECT_TRUE(c == expected);
+
+  EXPECT_THROW(s21::io::MulMatrixFiles<double>(b_path, b_path, c_path),
+               std::invalid_argument);
+  EXPECT_THROW(s21::io::MulMatrixFiles<float>(a_path, b_path, c_path),
+               std::invalid_argument);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+  std::remove(c_path.c_str());
+}
+
+TEST(stream, output_may_alias_input) {
+  const std::string a_path = "s21_alias_a.bin", b_path = "s21_alias_b.bin";
+  S21Matrix a(40, 40), b(40, 40);
+  for (int i = 0; i < 40; i++) {
+    for (int j = 0; j < 40; j++) {
+      a(i, j) = (i * 3 + j) % 7 - 3;
+      b(i, j) = (i + j * 5) % 6 * 0.5;
+    }
+  }
+  a.Save(a_path);
+  b.Save(b_path);
+  s21::io::StreamOptions options;
+  options.memory_budget = 5 * 16 * 16 * sizeof(double);
+
+  // A = A * B и B = A * B: входы читаются целиком до замены файла
+  s21::io::MulMatrixFiles<double>(a_path, b_path, a_path, options);
+  S21Matrix ab = a * b;
+  EXPECT_TRUE(S21Matrix::Load(a_path) == ab);
+  s21::io::MulMatrixFiles<double>(a_path, b_path, b_path, options);
+  EXPECT_TRUE(S21Matrix::Load(b_path) == ab * b);
+  std::FILE* temporary = std::fopen((b_path + ".tmp").c_str(), "rb");
+  EXPECT_EQ(temporary, nullptr);
+  if (temporary) std::fclose(temporary);
+
+  // При ошибке прежний файл C не меняется
+  EXPECT_THROW(s21::io::MulMatrixFiles<float>(a_path, b_path, b_path),
+               std::invalid_argument);
+  EXPECT_TRUE(S21Matrix::Load(b_path) == ab * b);
+  std::remove(a_path.c_str());
+  std::remove(b_path.c_str());
+}
+
+TEST(access, unchecked_const_and_rows) {
+  S21Matrix m(3, 5);
+  for (int i = 0; i < 3; i++)
+    for (double& x : m.Row(i)) x = i + 1;
+  m.At(2, 4) = 7;
+  const S21Matrix& c = m;
+  EXPECT_DOUBLE_EQ(c(1, 3), 2.0);
+  EXPECT_DOUBLE_EQ(c.At(2, 4), 7.0);
+  EXPECT_THROW(c(3, 0), std::out_of_range);
+  EXPECT_THROW(c.Row(-1), std::out_of_range);
+  EXPECT_EQ(c.Row(0).size(), 5u);
+  double sum = 0;
+  for (double x : c.Row(2)) sum += x;
+  EXPECT_DOUBLE_EQ(sum, 19.0);
+
+  // Хранение сплошное и после изменения числа столбцов, Data() не
+  // перевыделяет блок, обе версии видят одно и то же
+  const double* before = c.Data();
+  m.SetCols(2);
+  EXPECT_EQ(c.Data(), before);
+  EXPECT_EQ(m.Data(), c.Data());
+  EXPECT_EQ(m.GetColCapacity(), 5);
+  const double narrow[] = {1, 1, 2, 2, 3, 3};
+  for (int k = 0; k < 6; k++) EXPECT_DOUBLE_EQ(c.Data()[k], narrow[k]);
+  m.SetCols(4);
+  EXPECT_EQ(c.Data(), before);
+  const double wide[] = {1, 1, 0, 0, 2, 2, 0, 0, 3, 3, 0, 0};
+  for (int k = 0; k < 12; k++) EXPECT_DOUBLE_EQ(c.Data()[k], wide[k]);
+}
+
 int main() {
   testing::InitGoogleTest();
   return RUN_ALL_TESTS();
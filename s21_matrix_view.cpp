@@ -0,0 +1,167 @@
+#include "s21_matrix_view.h"
+
+#include "s21_matrix_gemm.h"
+#include "s21_matrix_oop.h"
+#include "s21_matrix_simd.h"
+
+/////////////          Окна        /////////////////
+
+template <typename T>
+S21BasicMatrixView<T>::S21BasicMatrixView(T* data, int rows, int cols,
+                                          int stride, bool transposed)
+    : data_(data),
+      rows_(rows),
+      cols_(cols),
+      stride_(stride),
+      transposed_(transposed) {}
+
+template <typename T>
+int S21BasicMatrixView<T>::GetRows() const {
+  return rows_;
+}
+
+template <typename T>
+int S21BasicMatrixView<T>::GetCols() const {
+  return cols_;
+}
+
+template <typename T>
+bool S21BasicMatrixView<T>::IsTransposed() const {
+  return transposed_;
+}
+
+template <typename T>
+T& S21BasicMatrixView<T>::operator()(int i, int j) const {
+  if (i < 0 || i >= rows_ || j < 0 || j >= cols_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  return data_[Offset(i, j)];
+}
+
+template <typename T>
+T* S21BasicMatrixView<T>::Data() const {
+  return data_;
+}
+
+template <typename T>
+std::ptrdiff_t S21BasicMatrixView<T>::RowStride() const {
+  return transposed_ ? 1 : stride_;
+}
+
+template <typename T>
+std::ptrdiff_t S21BasicMatrixView<T>::ColStride() const {
+  return transposed_ ? stride_ : 1;
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Block(int row, int col, int rows,
+                                                   int cols) const {
+  if (row < 0 || col < 0 || rows < 0 || cols < 0 || row + rows > rows_ ||
+      col + cols > cols_) {
+    throw std::out_of_range("Out of range. Incorrect input");
+  }
+  return S21BasicMatrixView(data_ + Offset(row, col), rows, cols, stride_,
+                            transposed_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Row(int i) const {
+  return Block(i, 0, 1, cols_);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Col(int j) const {
+  return Block(0, j, rows_, 1);
+}
+
+template <typename T>
+S21BasicMatrixView<T> S21BasicMatrixView<T>::Transposed() const {
+  return S21BasicMatrixView(data_, cols_, rows_, stride_, !transposed_);
+}
+
+/////////////          Операции на месте        /////////////////
+
+namespace {
+
+template <typename T>
+const T* LastElement(const S21BasicMatrixView<T>& view) {
+  return view.Data() + (view.GetRows() - 1) * view.RowStride() +
+         (view.GetCols() - 1) * view.ColStride();
+}
+
+template <typename T>
+bool Overlaps(const S21BasicMatrixView<T>& x, const S21BasicMatrixView<T>& y) {
+  return x.Data() <= LastElement(y) && y.Data() <= LastElement(x);
+}
+
+// dst(i, j) op= src(i, j); пересекающийся источник сначала копируется
+template <typename T, typename Op>
+void UpdateInPlace(const S21BasicMatrixView<T>& dst,
+                   const S21BasicMatrixView<T>& src, Op op) {
+  if (dst.GetRows() != src.GetRows() || dst.GetCols() != src.GetCols()) {
+    throw std::invalid_argument("Sizes of matrices are different");
+  }
+  if (dst.GetRows() == 0 || dst.GetCols() == 0) return;
+  if (Overlaps(dst, src)) {
+    S21BasicMatrix<T> copy(src);
+    UpdateInPlace(dst, copy.View(), op);
+    return;
+  }
+  for (int i = 0; i < dst.GetRows(); i++) {
+    for (int j = 0; j < dst.GetCols(); j++) {
+      op(dst.Data()[i * dst.RowStride() + j * dst.ColStride()],
+         src.ExprEval(i, j));
+    }
+  }
+}
+
+}  // namespace
+
+template <typename T>
+void S21BasicMatrixView<T>::SumMatrix(const S21BasicMatrixView& other) {
+  UpdateInPlace(*this, other, [](T& dst, T value) { dst += value; });
+}
+
+template <typename T>
+void S21BasicMatrixView<T>::SubMatrix(const S21BasicMatrixView& other) {
+  UpdateInPlace(*this, other, [](T& dst, T value) { dst -= value; });
+}
+
+template <typename T>
+void S21BasicMatrixView<T>::MulNumber(const T num) {
+  if (!transposed_) {
+    for (int i = 0; i < rows_; i++) {
+      s21::simd::Scale(data_ + Offset(i, 0), num, cols_);
+    }
+  } else {
+    for (int j = 0; j < cols_; j++) {
+      s21::simd::Scale(data_ + Offset(0, j), num, rows_);
+    }
+  }
+}
+
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& x,
+                            const S21BasicMatrixView<T>& y) {
+  if (x.GetCols() != y.GetRows()) {
+    throw std::invalid_argument(
+        "Count cols first matrix not equal count rows second matrix");
+  }
+  S21BasicMatrix<T> result(x.GetRows(), y.GetCols());
+  s21::Gemm(x.GetRows(), y.GetCols(), x.GetCols(), x.Data(), x.RowStride(),
+            x.ColStride(), y.Data(), y.RowStride(), y.ColStride(),
+            result.View().Data(), result.View().RowStride());
+  return result;
+}
+
+template class S21BasicMatrixView<float>;
+template class S21BasicMatrixView<double>;
+template class S21BasicMatrixView<long double>;
+
+template S21BasicMatrix<float> operator*(const S21BasicMatrixView<float>&,
+                                         const S21BasicMatrixView<float>&);
+template S21BasicMatrix<double> operator*(const S21BasicMatrixView<double>&,
+                                          const S21BasicMatrixView<double>&);
+template S21BasicMatrix<long double> operator*(
+    const S21BasicMatrixView<long double>&,
+    const S21BasicMatrixView<long double>&);
@@ -0,0 +1,106 @@
+#ifndef MATRIX_SRC_S21_MATRIX_VIEW_H
+#define MATRIX_SRC_S21_MATRIX_VIEW_H
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#if __cplusplus >= 202002L && __has_include(<span>)
+#include <span>
+#endif
+
+#include "s21_matrix_expr.h"
+
+// Непрерывный участок элементов (строка матрицы): std::span в C++20,
+// в C++17 — совместимый по основным методам заменитель
+#if __cplusplus >= 202002L && __has_include(<span>)
+template <typename T>
+using S21Span = std::span<T>;
+#else
+template <typename T>
+class S21Span {
+ public:
+  using element_type = T;
+  using value_type = std::remove_cv_t<T>;
+  using size_type = std::size_t;
+  using iterator = T*;
+
+  constexpr S21Span() = default;
+  constexpr S21Span(T* data, std::size_t size) : data_(data), size_(size) {}
+
+  constexpr T* data() const { return data_; }
+  constexpr std::size_t size() const { return size_; }
+  constexpr bool empty() const { return size_ == 0; }
+  constexpr T& operator[](std::size_t i) const { return data_[i]; }
+  constexpr T* begin() const { return data_; }
+  constexpr T* end() const { return data_ + size_; }
+
+ private:
+  T* data_ = nullptr;
+  std::size_t size_ = 0;
+};
+#endif
+
+template <typename T>
+class S21BasicMatrix;
+
+// Невладеющее окно в память S21BasicMatrix: строка, столбец, блок или
+// транспонированная матрица без копирования элементов.
+// Элемент (i, j) лежит по адресу data[i * stride + j], а у транспонированного
+// окна — по адресу data[j * stride + i]; data уже смещён на начало окна.
+// Окно действительно, пока жива исходная матрица и не меняется её размер.
+template <typename T>
+class S21BasicMatrixView : public S21MatrixExpr<S21BasicMatrixView<T>> {
+ public:
+  using value_type = T;
+  // Окно читает память, на которую может писать приёмник выражения
+  static constexpr bool kMayAlias = true;
+
+  S21BasicMatrixView(T* data, int rows, int cols, int stride,
+                     bool transposed = false);
+
+  int GetRows() const;
+  int GetCols() const;
+  bool IsTransposed() const;
+  T& operator()(int i, int j) const;
+
+  // Шаги между соседними элементами по строкам и по столбцам окна
+  T* Data() const;
+  std::ptrdiff_t RowStride() const;
+  std::ptrdiff_t ColStride() const;
+
+  S21BasicMatrixView Block(int row, int col, int rows, int cols) const;
+  S21BasicMatrixView Row(int i) const;
+  S21BasicMatrixView Col(int j) const;
+  S21BasicMatrixView Transposed() const;
+
+  // Операции на месте над элементами окна
+  void SumMatrix(const S21BasicMatrixView& other);
+  void SubMatrix(const S21BasicMatrixView& other);
+  void MulNumber(const T num);
+
+  // Интерфейс листа выражения
+  int ExprRows() const { return rows_; }
+  int ExprCols() const { return cols_; }
+  T ExprEval(int i, int j) const { return data_[Offset(i, j)]; }
+
+ private:
+  // Смещение элемента (i, j) окна от data_ в size_t
+  std::size_t Offset(int i, int j) const {
+    return transposed_ ? static_cast<std::size_t>(j) * stride_ + i
+                       : static_cast<std::size_t>(i) * stride_ + j;
+  }
+
+  T* data_;
+  int rows_, cols_;
+  int stride_;
+  bool transposed_;
+};
+
+using S21MatrixView = S21BasicMatrixView<double>;
+
+// Произведение окон в новую матрицу
+template <typename T>
+S21BasicMatrix<T> operator*(const S21BasicMatrixView<T>& x,
+                            const S21BasicMatrixView<T>& y);
+
+#endif  // MATRIX_SRC_S21_MATRIX_VIEW_H
@@ -0,0 +1,120 @@
+#include "s21_thread_pool.h"
+
+namespace {
+
+// Признак того, что текущий поток уже выполняет задачу пула
+thread_local bool tls_in_pool = false;
+
+int HardwareThreads() {
+  const unsigned count = std::thread::hardware_concurrency();
+  return count ? static_cast<int>(count) : 1;
+}
+
+}  // namespace
+
+S21ThreadPool::S21ThreadPool(int threads) {
+  StartWorkers(threads <= 0 ? HardwareThreads() : threads);
+}
+
+S21ThreadPool::~S21ThreadPool() { StopWorkers(); }
+
+S21ThreadPool& S21ThreadPool::Global() {
+  static S21ThreadPool pool;
+  return pool;
+}
+
+void S21ThreadPool::Resize(int threads) {
+  if (threads <= 0) threads = HardwareThreads();
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  if (threads == Size()) return;
+  StopWorkers();
+  StartWorkers(threads);
+}
+
+int S21ThreadPool::Size() const { return static_cast<int>(workers_.size()) + 1; }
+
+void S21ThreadPool::ParallelFor(int count,
+                                const std::function<void(int)>& body) {
+  if (count <= 0) return;
+  if (count == 1 || tls_in_pool) {
+    for (int i = 0; i < count; i++) body(i);
+    return;
+  }
+
+  std::lock_guard<std::mutex> run_lock(run_mutex_);
+  if (workers_.empty()) {
+    for (int i = 0; i < count; i++) body(i);
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    body_ = &body;
+    count_ = count;
+    next_.store(0, std::memory_order_relaxed);
+    active_ = static_cast<int>(workers_.size());
+    error_ = nullptr;
+    generation_++;
+  }
+  wake_.notify_all();
+
+  tls_in_pool = true;
+  RunTasks();
+  tls_in_pool = false;
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    body_ = nullptr;
+    error = error_;
+    error_ = nullptr;
+  }
+  if (error) std::rethrow_exception(error);
+}
+
+void S21ThreadPool::StartWorkers(int threads) {
+  stop_ = false;
+  for (int i = 1; i < threads; i++) {
+    workers_.emplace_back(&S21ThreadPool::WorkerLoop, this, generation_);
+  }
+}
+
+void S21ThreadPool::StopWorkers() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stop_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread& worker : workers_) {
+    worker.join();
+  }
+  workers_.clear();
+}
+
+void S21ThreadPool::WorkerLoop(unsigned long seen) {
+  tls_in_pool = true;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(mutex_);
+      wake_.wait(lock, [&] { return stop_ || generation_ != seen; });
+      if (stop_) return;
+      seen = generation_;
+    }
+    RunTasks();
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (--active_ == 0) done_.notify_one();
+  }
+}
+
+void S21ThreadPool::RunTasks() {
+  for (;;) {
+    const int index = next_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= count_) return;
+    try {
+      (*body_)(index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!error_) error_ = std::current_exception();
+    }
+  }
+}
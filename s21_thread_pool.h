@@ -0,0 +1,55 @@
+#ifndef MATRIX_SRC_S21_THREAD_POOL_H
+#define MATRIX_SRC_S21_THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Постоянный пул потоков для параллельных ядер библиотеки.
+// Потоки создаются один раз и ждут работы, поэтому вызов ParallelFor
+// не платит за запуск потоков. Вызывающий поток участвует в работе наравне
+// с рабочими, так что пул размера n держит n - 1 собственных потоков.
+class S21ThreadPool {
+ public:
+  explicit S21ThreadPool(int threads = 0);
+  S21ThreadPool(const S21ThreadPool&) = delete;
+  S21ThreadPool& operator=(const S21ThreadPool&) = delete;
+  ~S21ThreadPool();
+
+  // Общий пул библиотеки, по умолчанию по числу аппаратных потоков
+  static S21ThreadPool& Global();
+
+  // threads <= 0 — по числу аппаратных потоков
+  void Resize(int threads);
+  int Size() const;
+
+  // Выполняет body(0) ... body(count - 1) и ждёт завершения всех задач.
+  // Вложенный вызов из задачи пула выполняется последовательно.
+  // Первое выброшенное задачей исключение пробрасывается вызывающему.
+  void ParallelFor(int count, const std::function<void(int)>& body);
+
+ private:
+  void StartWorkers(int threads);
+  void StopWorkers();
+  void WorkerLoop(unsigned long seen);
+  void RunTasks();
+
+  std::vector<std::thread> workers_;
+  std::mutex run_mutex_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  std::condition_variable done_;
+  const std::function<void(int)>* body_ = nullptr;
+  int count_ = 0;
+  std::atomic<int> next_{0};
+  int active_ = 0;
+  unsigned long generation_ = 0;
+  bool stop_ = false;
+  std::exception_ptr error_;
+};
+
+#endif  // MATRIX_SRC_S21_THREAD_POOL_H